@@ -0,0 +1,38 @@
+/**
+ * Minimal host platform for running the benchmarks without a platform library.
+ * Uses std::chrono::steady_clock as the platform clock.
+ */
+
+#include "ExVectrCore.hpp"
+#include "ExVectrCore/time_base.hpp"
+#include "ExVectrCore/clock_source.hpp"
+
+#include <chrono>
+
+namespace
+{
+
+    /// @brief Platform clock using the host steady clock.
+    class Bench_Clock : public VCTR::Core::Clock_Source
+    {
+    private:
+        mutable VCTR::Core::Timestamped<int64_t> counter_;
+
+    public:
+        const VCTR::Core::Timestamped<int64_t> &getCounter() const override
+        {
+            counter_.data = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            counter_.timestamp = counter_.data;
+            return counter_;
+        }
+    };
+
+} // namespace to hide local classes.
+
+const VCTR::Core::Clock_Source &VCTR::Core::getPlatformClock()
+{
+    static Bench_Clock clock;
+    return clock;
+}
+
+void VCTR::Core::initialise() {}
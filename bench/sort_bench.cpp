@@ -0,0 +1,314 @@
+/**
+ * Benchmarks for ListBuffer::sortElements().
+ *
+ * Compares the previous recursive quicksort (last element pivot, through operator[]) with introsort and radix sort
+ * for different sizes and input orders. Sensor data is often already sorted or nearly so, which is the worst case for the previous version.
+ * Results are written to stdout, one line per run, as CSV (default) or JSON lines (--json).
+ *
+ * Usage: ExVectrCore_sort_bench [--json] [--quick]
+ *
+ * @note Build with optimisations (e.g. -DCMAKE_BUILD_TYPE=Release), otherwise results are meaningless.
+ */
+
+#include "ExVectrCore/list_buffer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    using namespace VCTR::Core;
+
+    typedef std::chrono::steady_clock Bench_Clock;
+
+    /// @brief Number of sorted elements per run.
+    constexpr size_t ELEMENTS_PER_RUN = 4000000;
+    /// @brief A run stops early after this much sort time, as the previous quicksort is quadratic on sorted input.
+    constexpr int64_t MAX_RUN_NS = 2000000000;
+
+    /// @brief Output as JSON lines instead of CSV.
+    bool outputJson = false;
+    /// @brief Divides the work per run by 10 for a fast smoke run.
+    bool quickRun = false;
+
+    inline int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Bench_Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief One line of results.
+     */
+    struct Bench_Result
+    {
+        const char *algorithm;
+        const char *type;
+        const char *order;
+        size_t elements;
+        size_t runs;
+        double nsPerSort;
+        double nsPerElement;
+    };
+
+    void printHeader()
+    {
+        if (outputJson)
+            return;
+        std::cout << "algorithm,type,order,elements,runs,ns_per_sort,ns_per_element\n";
+    }
+
+    void printResult(const Bench_Result &result)
+    {
+        if (outputJson)
+        {
+            std::cout << "{\"algorithm\":\"" << result.algorithm << "\",\"type\":\"" << result.type << "\",\"order\":\"" << result.order
+                      << "\",\"elements\":" << result.elements << ",\"runs\":" << result.runs << ",\"ns_per_sort\":" << result.nsPerSort
+                      << ",\"ns_per_element\":" << result.nsPerElement << "}\n";
+        }
+        else
+        {
+            std::cout << result.algorithm << ',' << result.type << ',' << result.order << ',' << result.elements << ',' << result.runs << ','
+                      << result.nsPerSort << ',' << result.nsPerElement << '\n';
+        }
+        std::cout.flush();
+    }
+
+    // Previous ListBuffer::sortElements(), kept here as baseline.
+
+    template <typename T, size_t SIZE>
+    size_t legacyPartition(ListBuffer<T, SIZE> &buffer, size_t left, size_t right)
+    {
+        T pivot = buffer[right];
+
+        size_t i = left;
+
+        for (size_t j = left; j < right; j++)
+        {
+            if (buffer[j] < pivot)
+            {
+                T temp = buffer[i];
+                buffer[i] = buffer[j];
+                buffer[j] = temp;
+                i++;
+            }
+        }
+
+        T temp = buffer[i];
+        buffer[i] = buffer[right];
+        buffer[right] = temp;
+
+        return i;
+    }
+
+    template <typename T, size_t SIZE>
+    void legacyQuickSort(ListBuffer<T, SIZE> &buffer, size_t left, size_t right)
+    {
+        if (left < right)
+        {
+            size_t p = legacyPartition(buffer, left, right);
+            if (p != left)
+                legacyQuickSort(buffer, left, p - 1);
+            legacyQuickSort(buffer, p + 1, right);
+        }
+    }
+
+    template <typename T, size_t SIZE>
+    void legacySort(ListBuffer<T, SIZE> &buffer, T *)
+    {
+        if (buffer.size() > 1)
+            legacyQuickSort(buffer, 0, buffer.size() - 1);
+    }
+
+    template <typename T, size_t SIZE>
+    void introSort(ListBuffer<T, SIZE> &buffer, T *)
+    {
+        buffer.sortElements();
+    }
+
+    template <typename T, size_t SIZE>
+    void radixSort(ListBuffer<T, SIZE> &buffer, T *scratch)
+    {
+        buffer.sortElements(scratch);
+    }
+
+    /**
+     * @brief Input orders. Values are in index order of the buffer.
+     */
+    enum class Order
+    {
+        RANDOM,
+        SORTED,
+        REVERSED,
+        NEARLY_SORTED,
+        FEW_UNIQUE
+    };
+
+    const char *orderName(Order order)
+    {
+        switch (order)
+        {
+        case Order::RANDOM:
+            return "random";
+        case Order::SORTED:
+            return "sorted";
+        case Order::REVERSED:
+            return "reversed";
+        case Order::NEARLY_SORTED:
+            return "nearly_sorted";
+        case Order::FEW_UNIQUE:
+            return "few_unique";
+        }
+        return "";
+    }
+
+    template <typename T>
+    const char *typeName();
+
+    template <>
+    const char *typeName<float>() { return "float"; }
+
+    template <>
+    const char *typeName<int32_t>() { return "int32"; }
+
+    template <typename T>
+    std::vector<T> makeInput(size_t size, Order order)
+    {
+        std::mt19937 random(1234);
+        std::vector<T> input(size);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            switch (order)
+            {
+            case Order::RANDOM:
+                input[i] = T(std::uniform_int_distribution<int32_t>(-1000000, 1000000)(random)) / T(7);
+                break;
+            case Order::SORTED:
+                input[i] = T(i);
+                break;
+            case Order::REVERSED:
+                input[i] = T(size - i);
+                break;
+            case Order::NEARLY_SORTED:
+                // Slowly rising signal with noise, like a temperature sensor.
+                input[i] = T(i) + T(std::uniform_int_distribution<int32_t>(-8, 8)(random));
+                break;
+            case Order::FEW_UNIQUE:
+                input[i] = T(std::uniform_int_distribution<int32_t>(0, 3)(random));
+                break;
+            }
+        }
+
+        return input;
+    }
+
+    /**
+     * @brief Fills a buffer with input, so that the elements wrap around the end of the array as in a running buffer.
+     */
+    template <typename T, size_t SIZE>
+    void fillBuffer(ListBuffer<T, SIZE> &buffer, const std::vector<T> &input)
+    {
+        buffer.clear();
+        for (size_t i = 0; i < SIZE / 2; i++)
+            buffer.placeFront(T(), true);
+        // Placed oldest first, so the last input is at index 0.
+        for (size_t i = input.size(); i > 0; i--)
+            buffer.placeFront(input[i - 1], true);
+    }
+
+    template <typename T, size_t SIZE>
+    void benchSort(const char *name, void (*sort)(ListBuffer<T, SIZE> &, T *), Order order)
+    {
+        static ListBuffer<T, SIZE> buffer;
+        static T scratch[SIZE];
+
+        std::vector<T> input = makeInput<T>(SIZE, order);
+
+        size_t runs = ELEMENTS_PER_RUN / SIZE / (quickRun ? 10 : 1);
+        if (runs == 0)
+            runs = 1;
+
+        int64_t total = 0;
+        for (size_t run = 0; run < runs; run++)
+        {
+            fillBuffer(buffer, input);
+
+            int64_t start = nowNs();
+            sort(buffer, scratch);
+            total += nowNs() - start;
+
+            if (total > MAX_RUN_NS)
+            {
+                runs = run + 1;
+                break;
+            }
+        }
+
+        for (size_t i = 1; i < buffer.size(); i++)
+        {
+            if (buffer[i] < buffer[i - 1])
+            {
+                std::cerr << name << " did not sort.\n";
+                break;
+            }
+        }
+
+        Bench_Result result;
+        result.algorithm = name;
+        result.type = typeName<T>();
+        result.order = orderName(order);
+        result.elements = SIZE;
+        result.runs = runs;
+        result.nsPerSort = double(total) / runs;
+        result.nsPerElement = result.nsPerSort / SIZE;
+        printResult(result);
+    }
+
+    template <typename T, size_t SIZE>
+    void benchSize()
+    {
+        const Order orders[] = {Order::RANDOM, Order::SORTED, Order::REVERSED, Order::NEARLY_SORTED, Order::FEW_UNIQUE};
+
+        for (Order order : orders)
+        {
+            benchSort<T, SIZE>("legacy_quicksort", legacySort<T, SIZE>, order);
+            benchSort<T, SIZE>("introsort", introSort<T, SIZE>, order);
+            benchSort<T, SIZE>("radix", radixSort<T, SIZE>, order);
+        }
+    }
+
+} // namespace to hide local functions.
+
+int main(int argc, char **argv)
+{
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+            outputJson = true;
+        else if (strcmp(argv[i], "--quick") == 0)
+            quickRun = true;
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--json] [--quick]\n";
+            return 1;
+        }
+    }
+
+    printHeader();
+
+    benchSize<float, 64>();
+    benchSize<float, 1024>();
+    benchSize<float, 8192>();
+
+    benchSize<int32_t, 64>();
+    benchSize<int32_t, 1024>();
+    benchSize<int32_t, 8192>();
+
+    return 0;
+}
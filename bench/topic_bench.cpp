@@ -0,0 +1,388 @@
+/**
+ * Benchmarks for Topic::publish().
+ *
+ * Measures throughput and latency for different subscriber counts, subscriber kinds, payload sizes and
+ * for publishing to a subscriber read by another thread. Results are written to stdout, one line per run,
+ * as CSV (default) or JSON lines (--json), so they can be compared between builds to catch regressions.
+ *
+ * Usage: ExVectrCore_bench [--json] [--quick]
+ *
+ * @note Build with optimisations (e.g. -DCMAKE_BUILD_TYPE=Release), otherwise results are meaningless.
+ */
+
+#include "ExVectrCore/topic.hpp"
+#include "ExVectrCore/topic_subscribers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    using namespace VCTR::Core;
+
+    typedef std::chrono::steady_clock Bench_Clock;
+
+    /// @brief Number of individually timed publishes used for latency percentiles.
+    constexpr size_t LATENCY_SAMPLES = 10000;
+    /// @brief Number of deliveries (publishes * subscribers) per run.
+    constexpr size_t DELIVERIES_PER_RUN = 4000000;
+
+    /// @brief Output as JSON lines instead of CSV.
+    bool outputJson = false;
+    /// @brief Divides the work per run by 10 for a fast smoke run.
+    bool quickRun = false;
+
+    inline int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Bench_Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Published item. The send time is used to measure cross thread latency.
+     */
+    template <size_t SIZE>
+    struct Payload
+    {
+        static_assert(SIZE >= 16, "Payload needs space for the send time.");
+
+        int64_t sent;
+        uint8_t data[SIZE - sizeof(int64_t)];
+    };
+
+    /**
+     * @brief One line of results.
+     */
+    struct Bench_Result
+    {
+        const char *benchmark;
+        const char *kind;
+        const char *mode;
+        size_t subscribers;
+        size_t payloadBytes;
+        size_t items;
+        double nsPerPublish;
+        double nsPerDelivery;
+        double itemsPerSecond;
+        double p50Ns;
+        double p99Ns;
+        size_t dropped;
+    };
+
+    void printHeader()
+    {
+        if (outputJson)
+            return;
+        std::cout << "benchmark,kind,mode,subscribers,payload_bytes,items,ns_per_publish,ns_per_delivery,items_per_second,p50_ns,p99_ns,dropped\n";
+    }
+
+    void printResult(const Bench_Result &result)
+    {
+        if (outputJson)
+        {
+            std::cout << "{\"benchmark\":\"" << result.benchmark << "\",\"kind\":\"" << result.kind << "\",\"mode\":\"" << result.mode
+                      << "\",\"subscribers\":" << result.subscribers << ",\"payload_bytes\":" << result.payloadBytes << ",\"items\":" << result.items
+                      << ",\"ns_per_publish\":" << result.nsPerPublish << ",\"ns_per_delivery\":" << result.nsPerDelivery
+                      << ",\"items_per_second\":" << result.itemsPerSecond << ",\"p50_ns\":" << result.p50Ns << ",\"p99_ns\":" << result.p99Ns
+                      << ",\"dropped\":" << result.dropped << "}\n";
+        }
+        else
+        {
+            std::cout << result.benchmark << ',' << result.kind << ',' << result.mode << ',' << result.subscribers << ',' << result.payloadBytes << ','
+                      << result.items << ',' << result.nsPerPublish << ',' << result.nsPerDelivery << ',' << result.itemsPerSecond << ','
+                      << result.p50Ns << ',' << result.p99Ns << ',' << result.dropped << '\n';
+        }
+        std::cout.flush();
+    }
+
+    /**
+     * @brief Sorts the samples and writes the 50th and 99th percentile into result.
+     */
+    void setPercentiles(std::vector<int64_t> &samples, Bench_Result &result)
+    {
+        if (samples.empty())
+            return;
+
+        std::sort(samples.begin(), samples.end());
+        result.p50Ns = double(samples[samples.size() / 2]);
+        result.p99Ns = double(samples[samples.size() * 99 / 100]);
+    }
+
+    /// @brief Keeps the compiler from removing work on received items.
+    std::atomic<uint64_t> staticSinkCount(0);
+
+    template <typename T>
+    void staticSink(const T &item)
+    {
+        staticSinkCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    struct Callback_Sink
+    {
+        uint64_t count = 0;
+
+        void onItem(const T &item) { count++; }
+    };
+
+    // Subscriber kinds. Each creates one subscriber of its kind subscribed to the given topic.
+
+    struct Kind_Simple
+    {
+        static const char *name() { return "Simple_Subscriber"; }
+
+        template <typename T>
+        static Subscriber<T> *create(Topic<T> &topic, Callback_Sink<T> &sink) { return new Simple_Subscriber<T>(topic); }
+    };
+
+    struct Kind_Buffer
+    {
+        static const char *name() { return "Buffer_Subscriber"; }
+
+        template <typename T>
+        static Subscriber<T> *create(Topic<T> &topic, Callback_Sink<T> &sink) { return new Buffer_Subscriber<T, 64>(topic, true); }
+    };
+
+    struct Kind_Callback
+    {
+        static const char *name() { return "Callback_Subscriber"; }
+
+        template <typename T>
+        static Subscriber<T> *create(Topic<T> &topic, Callback_Sink<T> &sink)
+        {
+            return new Callback_Subscriber<T, Callback_Sink<T>>(topic, &sink, &Callback_Sink<T>::onItem);
+        }
+    };
+
+    struct Kind_StaticCallback
+    {
+        static const char *name() { return "StaticCallback_Subscriber"; }
+
+        template <typename T>
+        static Subscriber<T> *create(Topic<T> &topic, Callback_Sink<T> &sink) { return new StaticCallback_Subscriber<T>(topic, staticSink<T>); }
+    };
+
+    /**
+     * @brief Publishes on a topic with given number of subscribers of one kind, all on the same thread.
+     */
+    template <typename KIND, size_t SIZE>
+    void benchPublish(size_t numSubscribers)
+    {
+        typedef Payload<SIZE> Item;
+
+        Topic<Item> topic;
+        Callback_Sink<Item> sink;
+        std::vector<std::unique_ptr<Subscriber<Item>>> subscribers;
+        for (size_t i = 0; i < numSubscribers; i++)
+            subscribers.emplace_back(KIND::template create<Item>(topic, sink));
+
+        size_t items = std::max<size_t>(DELIVERIES_PER_RUN / (quickRun ? 10 : 1) / numSubscribers, 1000);
+
+        Item item;
+        memset(&item, 0, sizeof(item));
+
+        for (size_t i = 0; i < items / 10; i++) // Warm up caches.
+            topic.publish(item);
+
+        int64_t start = nowNs();
+        for (size_t i = 0; i < items; i++)
+        {
+            item.sent = int64_t(i);
+            topic.publish(item);
+        }
+        int64_t duration = nowNs() - start;
+
+        size_t numSamples = std::min(items, LATENCY_SAMPLES);
+        std::vector<int64_t> samples(numSamples);
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            int64_t publishStart = nowNs();
+            topic.publish(item);
+            samples[i] = nowNs() - publishStart;
+        }
+
+        Bench_Result result = {};
+        result.benchmark = "publish";
+        result.kind = KIND::name();
+        result.mode = "same_thread";
+        result.subscribers = numSubscribers;
+        result.payloadBytes = SIZE;
+        result.items = items;
+        result.nsPerPublish = double(duration) / items;
+        result.nsPerDelivery = double(duration) / (items * numSubscribers);
+        result.itemsPerSecond = items * 1e9 / double(duration);
+        setPercentiles(samples, result);
+
+        printResult(result);
+    }
+
+    template <typename KIND, size_t SIZE>
+    void benchPublishCounts()
+    {
+        const size_t counts[] = {1, 10, 100, 1000};
+        for (size_t count : counts)
+            benchPublish<KIND, SIZE>(count);
+    }
+
+    template <size_t SIZE>
+    void benchPublishKinds()
+    {
+        benchPublishCounts<Kind_Simple, SIZE>();
+        benchPublishCounts<Kind_Buffer, SIZE>();
+        benchPublishCounts<Kind_Callback, SIZE>();
+        benchPublishCounts<Kind_StaticCallback, SIZE>();
+    }
+
+    /**
+     * @brief Publishes to a SPSC_Buffer_Subscriber read by another thread. Latency is from publish to being taken by the reader.
+     */
+    template <size_t SIZE>
+    void benchCrossThread()
+    {
+        typedef Payload<SIZE> Item;
+
+        Topic<Item> topic;
+        SPSC_Buffer_Subscriber<Item, 1024> subscriber(topic);
+
+        size_t items = DELIVERIES_PER_RUN / (quickRun ? 40 : 4);
+        std::vector<int64_t> samples;
+        samples.reserve(LATENCY_SAMPLES);
+
+        std::atomic<bool> done(false);
+        std::thread reader([&]() {
+            Item received[64];
+            size_t numReceived = 0;
+            size_t sampleInterval = std::max<size_t>(items / LATENCY_SAMPLES, 1);
+
+            while (!done.load(std::memory_order_acquire) || !subscriber.isEmpty())
+            {
+                size_t num = subscriber.takeBackN(received, 64);
+                if (num == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                int64_t now = nowNs();
+                for (size_t i = 0; i < num; i++)
+                {
+                    if ((numReceived + i) % sampleInterval == 0 && samples.size() < LATENCY_SAMPLES)
+                        samples.push_back(now - received[i].sent);
+                }
+                numReceived += num;
+            }
+        });
+
+        Item item;
+        memset(&item, 0, sizeof(item));
+
+        int64_t start = nowNs();
+        for (size_t i = 0; i < items; i++)
+        {
+            while (subscriber.isFull()) // Wait for the reader instead of measuring dropped items.
+                std::this_thread::yield();
+
+            item.sent = nowNs();
+            topic.publish(item);
+        }
+
+        done.store(true, std::memory_order_release);
+        reader.join();
+        int64_t duration = nowNs() - start;
+
+        Bench_Result result = {};
+        result.benchmark = "publish";
+        result.kind = "SPSC_Buffer_Subscriber";
+        result.mode = "cross_thread";
+        result.subscribers = 1;
+        result.payloadBytes = SIZE;
+        result.items = items;
+        result.nsPerPublish = double(duration) / items;
+        result.nsPerDelivery = result.nsPerPublish;
+        result.itemsPerSecond = items * 1e9 / double(duration);
+        result.dropped = subscriber.getDroppedItems();
+        setPercentiles(samples, result);
+
+        printResult(result);
+    }
+
+    /**
+     * @brief Publishes heap owning payloads by copy and by move to a single Simple_Subscriber.
+     */
+    void benchVectorPayload(size_t size, bool move)
+    {
+        Topic<std::vector<uint8_t>> topic;
+        Simple_Subscriber<std::vector<uint8_t>> subscriber(topic);
+
+        size_t items = DELIVERIES_PER_RUN / (quickRun ? 100 : 10);
+
+        int64_t start = nowNs();
+        for (size_t i = 0; i < items; i++)
+        {
+            std::vector<uint8_t> item(size, uint8_t(i));
+            if (move)
+                topic.publish(std::move(item));
+            else
+                topic.publish(item);
+        }
+        int64_t duration = nowNs() - start;
+
+        Bench_Result result = {};
+        result.benchmark = "publish_vector";
+        result.kind = "Simple_Subscriber";
+        result.mode = move ? "move" : "copy";
+        result.subscribers = 1;
+        result.payloadBytes = size;
+        result.items = items;
+        result.nsPerPublish = double(duration) / items;
+        result.nsPerDelivery = result.nsPerPublish;
+        result.itemsPerSecond = items * 1e9 / double(duration);
+
+        printResult(result);
+    }
+
+} // namespace to hide local benchmarks.
+
+int main(int argc, char **argv)
+{
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+            outputJson = true;
+        else if (strcmp(argv[i], "--quick") == 0)
+            quickRun = true;
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--json] [--quick]\n";
+            return 1;
+        }
+    }
+
+    printHeader();
+
+    benchPublishKinds<16>();
+    benchPublishKinds<64>();
+    benchPublishKinds<256>();
+    benchPublishKinds<1024>();
+
+    benchCrossThread<16>();
+    benchCrossThread<64>();
+    benchCrossThread<256>();
+    benchCrossThread<1024>();
+
+    const size_t vectorSizes[] = {64, 4096};
+    for (size_t size : vectorSizes)
+    {
+        benchVectorPayload(size, false);
+        benchVectorPayload(size, true);
+    }
+
+    return 0;
+}
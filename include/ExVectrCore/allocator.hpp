@@ -0,0 +1,286 @@
+#ifndef EXVECTRCORE_ALLOCATOR_HPP
+#define EXVECTRCORE_ALLOCATOR_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Allocators let heap users like ListArray take memory from somewhere other than the global heap.
+         * On long running nodes this bounds fragmentation and allocation time:
+         *  - Allocator_Arena: bump pointer. Freeing is a no-op until reset(). For setup time or per cycle scratch memory.
+         *  - Allocator_Pool: fixed size blocks. O(1), no fragmentation. For many objects of the same size.
+         *  - Allocator_TLSF: two level segregated fit. O(1) general purpose allocator with bounded fragmentation.
+         *
+         * e.g.
+         *      static uint8_t memory[16384];
+         *      Allocator_TLSF allocator(memory, sizeof(memory));
+         *      ListArray<float> list(allocator);
+         *
+         * @note Allocators are not thread safe.
+         */
+
+        /**
+         * @brief Usage statistics of an allocator.
+         */
+        struct Allocator_Stats
+        {
+            /// @brief Number of bytes the allocator manages. 0 if unbounded (heap).
+            size_t capacity = 0;
+            /// @brief Number of bytes currently allocated, including internal rounding.
+            size_t bytesInUse = 0;
+            /// @brief Highest value bytesInUse reached.
+            size_t peakBytesInUse = 0;
+            /// @brief Number of successful allocations.
+            size_t numAllocations = 0;
+            /// @brief Number of deallocations.
+            size_t numFrees = 0;
+            /// @brief Number of allocations that failed.
+            size_t numFailures = 0;
+        };
+
+        /**
+         * @brief Interface for memory allocators.
+         */
+        class Allocator
+        {
+        public:
+            /// @brief Alignment of memory returned when none is given. Enough for any fundamental type.
+            static constexpr size_t DEFAULT_ALIGNMENT = alignof(max_align_t);
+
+        protected:
+            Allocator_Stats stats_;
+
+        public:
+            virtual ~Allocator() {}
+
+            /**
+             * @brief Allocates memory.
+             * @param size Number of bytes.
+             * @param alignment Alignment of the memory. Must be a power of two.
+             * @returns pointer to the memory or nullptr if out of memory.
+             */
+            virtual void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) = 0;
+
+            /**
+             * @brief Returns memory given by allocate().
+             * @param ptr Memory to free. Does nothing if nullptr.
+             * @param size Size given when allocating.
+             */
+            virtual void deallocate(void *ptr, size_t size) = 0;
+
+            /**
+             * @brief Changes the size of memory given by allocate(). Contents up to the smaller size are kept.
+             * Default implementation allocates new memory and copies.
+             * @param ptr Memory to resize. If nullptr same as allocate().
+             * @param oldSize Size given when allocating.
+             * @param newSize New size in bytes. If 0 the memory is freed.
+             * @param alignment Alignment given when allocating.
+             * @returns pointer to the resized memory. nullptr if out of memory, in which case ptr is still valid.
+             */
+            virtual void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment = DEFAULT_ALIGNMENT);
+
+            /**
+             * @returns the usage statistics.
+             */
+            const Allocator_Stats &getStats() const { return stats_; }
+
+        protected:
+            void recordAllocation(size_t size);
+
+            void recordFree(size_t size);
+
+            void recordFailure();
+        };
+
+        /**
+         * @returns the allocator using the global heap (malloc and free). Used when no allocator is given.
+         */
+        Allocator &getHeapAllocator();
+
+        /**
+         * @brief Bump pointer allocator on a given block of memory. Allocating only moves a pointer forward.
+         * Freeing only gives memory back if it was the last allocation, otherwise memory is reclaimed with reset().
+         */
+        class Allocator_Arena : public Allocator
+        {
+        private:
+            uint8_t *start_ = nullptr;
+            uint8_t *end_ = nullptr;
+            uint8_t *current_ = nullptr;
+            /// @brief Start of last allocation. Allows freeing and growing it in place.
+            uint8_t *last_ = nullptr;
+
+        public:
+            /**
+             * @param memory Memory to allocate from. Must stay valid while in use.
+             * @param size Size of memory in bytes.
+             */
+            Allocator_Arena(void *memory, size_t size);
+
+            void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+            void deallocate(void *ptr, size_t size) override;
+
+            void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+            /**
+             * @brief Frees all allocations at once. Memory given out before must no longer be used.
+             */
+            void reset();
+
+            /**
+             * @returns number of bytes left.
+             */
+            size_t getRemaining() const;
+        };
+
+        /**
+         * @brief Allocates blocks of a single size from a given block of memory. Free blocks are kept in a list, so both allocating and freeing are O(1).
+         * Allocations larger than the block size fail.
+         */
+        class Allocator_Pool : public Allocator
+        {
+        private:
+            struct Free_Block
+            {
+                Free_Block *next;
+            };
+
+            size_t blockSize_ = 0;
+            size_t numBlocks_ = 0;
+            size_t numFree_ = 0;
+            Free_Block *freeList_ = nullptr;
+
+        public:
+            /**
+             * @param memory Memory to allocate from. Must stay valid while in use.
+             * @param size Size of memory in bytes.
+             * @param blockSize Size of each block in bytes. Rounded up to DEFAULT_ALIGNMENT.
+             */
+            Allocator_Pool(void *memory, size_t size, size_t blockSize);
+
+            void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+            void deallocate(void *ptr, size_t size) override;
+
+            void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+            /**
+             * @returns size of each block in bytes.
+             */
+            size_t getBlockSize() const;
+
+            /**
+             * @returns total number of blocks.
+             */
+            size_t getNumBlocks() const;
+
+            /**
+             * @returns number of free blocks.
+             */
+            size_t getNumFree() const;
+        };
+
+        /**
+         * @brief General purpose allocator on a given block of memory using two level segregated fit (TLSF).
+         * Free blocks are sorted into size classes by two bitmaps, so finding a fitting block, splitting and merging neighbours all take constant time.
+         * Returned memory is aligned to ALIGNMENT. Larger alignments fail.
+         */
+        class Allocator_TLSF : public Allocator
+        {
+        public:
+            /// @brief Alignment of all returned memory.
+            static constexpr size_t ALIGNMENT = 2 * sizeof(void *);
+
+        private:
+            /// @brief Number of second level classes per first level class is 2^SL_BITS.
+            static constexpr size_t SL_BITS = 4;
+            static constexpr size_t SL_COUNT = size_t(1) << SL_BITS;
+            /// @brief Blocks below 2^FL_SHIFT bytes are all in first level 0, split linearly.
+            static constexpr size_t FL_SHIFT = SL_BITS + (sizeof(void *) > 4 ? 4 : 3);
+            static constexpr size_t SMALL_BLOCK = size_t(1) << FL_SHIFT;
+            /// @brief Memory above 2^FL_MAX bytes is not used.
+            static constexpr size_t FL_MAX = sizeof(size_t) > 4 ? 32 : 30;
+            static constexpr size_t FL_COUNT = FL_MAX - FL_SHIFT + 1;
+
+            /**
+             * @brief Header before every block. Free list pointers are only valid in free blocks and overlap the memory given out.
+             */
+            struct Block
+            {
+                /// @brief Block physically before this one. nullptr for the first block.
+                Block *prevPhysical;
+                /// @brief Size of the memory after the header. Lowest bit is set if free.
+                size_t size;
+                Block *nextFree;
+                Block *prevFree;
+            };
+
+            static constexpr size_t HEADER_SIZE = 2 * sizeof(void *);
+            static constexpr size_t MIN_BLOCK_SIZE = sizeof(Block) - HEADER_SIZE;
+
+            uint32_t flBitmap_ = 0;
+            uint32_t slBitmap_[FL_COUNT] = {};
+            Block *freeLists_[FL_COUNT][SL_COUNT] = {};
+
+        public:
+            /**
+             * @param memory Memory to allocate from. Must stay valid while in use.
+             * @param size Size of memory in bytes.
+             */
+            Allocator_TLSF(void *memory, size_t size);
+
+            void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+            void deallocate(void *ptr, size_t size) override;
+
+            void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment = DEFAULT_ALIGNMENT) override;
+
+        private:
+            static size_t blockSize(const Block *block);
+
+            static bool isFree(const Block *block);
+
+            static Block *nextPhysical(const Block *block);
+
+            static void *toMemory(Block *block);
+
+            static Block *toBlock(void *memory);
+
+            /**
+             * @brief Gets size class of a block of given size.
+             */
+            static void mapping(size_t size, size_t &fl, size_t &sl);
+
+            /**
+             * @brief Finds a free block of at least size. Removes it from its free list.
+             */
+            Block *findFree(size_t size);
+
+            void insertFree(Block *block);
+
+            void removeFree(Block *block);
+
+            /**
+             * @brief Splits block to given size. Remaining memory becomes a new free block.
+             */
+            void split(Block *block, size_t size);
+
+            /**
+             * @brief Merges a free block with free physical neighbours.
+             * @returns the merged block.
+             */
+            Block *merge(Block *block);
+        };
+
+    }
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include "stdint.h"
 #include "stddef.h"
 #include "math.h"
+#include "string.h"
 
 #include "list_buffer.hpp"
 
@@ -48,6 +49,11 @@ namespace VCTR
             */
             size_t getPtr() const;
 
+            /**
+             * @brief gets the raw buffer. Use getPtr() for the number of bytes written.
+            */
+            const uint8_t *getData() const;
+
             /// @brief Writes a value to the buffer. The pointer is incremented by the size of the data.
             /// @note Float/Double data will be added in their raw form. Use writeFactor() to use a platform independent format at the cost of performance.
             template <typename TYPE>
@@ -125,6 +131,12 @@ namespace VCTR
             return ptr_;
         }
 
+        template <size_t SIZE>
+        const uint8_t *DataBuffer<SIZE>::getData() const
+        {
+            return buffer_;
+        }
+
         template <size_t SIZE>
         template <typename TYPE>
         void DataBuffer<SIZE>::write(const TYPE& data)
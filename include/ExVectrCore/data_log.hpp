@@ -0,0 +1,564 @@
+#ifndef EXVECTRCORE_DATALOG_HPP
+#define EXVECTRCORE_DATALOG_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include <type_traits>
+
+#include "list_array.hpp"
+#include "task_types.hpp"
+#include "scheduler2.hpp"
+#include "timestamped.hpp"
+#include "topic.hpp"
+#include "topic_handle.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Binary data log format:
+         *
+         * File header (16 bytes):      "VCTRLOG" + version (uint8_t), max chunk payload size (uint32_t, 0 if unknown), reserved (4 bytes).
+         * Followed by chunks, each:    DataLog_ChunkHeader (32 bytes) + payload.
+         * Payload is a list of records: channel (uint16_t), data size (uint16_t), timestamp (int64_t), data.
+         *
+         * Each chunk header carries the timestamps of its first and last record, which is used as a time index.
+         * The payload is protected by a CRC computed with computeCrc().
+         * All values are stored in the platforms byte order.
+         */
+
+        /// @brief Version of the log format written by DataLog_Writer.
+        constexpr uint8_t DATALOG_VERSION = 1;
+        /// @brief Size of the file header in bytes.
+        constexpr size_t DATALOG_FILEHEADER_SIZE = 16;
+        /// @brief Size of a chunk header in bytes.
+        constexpr size_t DATALOG_CHUNKHEADER_SIZE = 32;
+        /// @brief Size of a record header in bytes. Record data follows directly after.
+        constexpr size_t DATALOG_RECORDHEADER_SIZE = 12;
+
+        /**
+         * @brief Header placed in front of each chunk of records.
+         */
+        struct DataLog_ChunkHeader
+        {
+            /// @brief Number of payload bytes following the header.
+            uint32_t payloadSize = 0;
+            /// @brief Number of records in the payload.
+            uint32_t numRecords = 0;
+            /// @brief CRC of the payload.
+            uint32_t crc = 0;
+            /// @brief Timestamp of the first record in chunk.
+            int64_t firstTimestamp = 0;
+            /// @brief Timestamp of the last record in chunk.
+            int64_t lastTimestamp = 0;
+
+            /**
+             * @brief Writes the header into the given buffer.
+             * @param buffer Must be at least DATALOG_CHUNKHEADER_SIZE bytes large.
+             */
+            void serialize(uint8_t *buffer) const;
+
+            /**
+             * @brief Reads the header from the given buffer.
+             * @param buffer Must be at least DATALOG_CHUNKHEADER_SIZE bytes large.
+             * @returns false if the buffer does not contain a chunk header.
+             */
+            bool deserialize(const uint8_t *buffer);
+        };
+
+        /**
+         * @brief Interface class for where the log is stored. Usually a file, implemented by the platform or DataLog_File.
+         */
+        class DataLog_Storage
+        {
+        public:
+            virtual ~DataLog_Storage() {}
+
+            /**
+             * @brief Writes the given data to the current position.
+             * @returns number of bytes written.
+             */
+            virtual size_t write(const void *data, size_t size) = 0;
+
+            /**
+             * @brief Reads data from the current position.
+             * @returns number of bytes read.
+             */
+            virtual size_t read(void *data, size_t size) = 0;
+
+            /**
+             * @brief Sets the position for the next read or write.
+             * @returns true if successful.
+             */
+            virtual bool seek(size_t position) = 0;
+
+            /**
+             * @returns the current read/write position.
+             */
+            virtual size_t position() const = 0;
+
+            /**
+             * @brief Makes sure all written data is actually stored. Defaults to doing nothing.
+             */
+            virtual void flush() {}
+        };
+
+        /**
+         * @brief Collects records into chunks in memory and writes full chunks to storage from its own task.
+         * Recording a record is only a copy into ram, so publishing tasks are never blocked by storage I/O.
+         * If all chunks are waiting to be written, new records are dropped and counted. @see getDroppedRecords()
+         * @note Add the writer to the same scheduler as the recording tasks. Partly filled chunks are written after maxChunkAge_ns.
+         */
+        class DataLog_Writer : public Task_Periodic
+        {
+        private:
+            /// @brief Where the log is written to.
+            DataLog_Storage *storage_ = nullptr;
+            /// @brief Memory for all chunks. Each chunk has space for its header followed by the payload.
+            uint8_t *chunkMemory_ = nullptr;
+            /// @brief Header of each chunk.
+            DataLog_ChunkHeader *chunkHeaders_ = nullptr;
+            /// @brief Max payload size of a single chunk.
+            size_t chunkSize_ = 0;
+            /// @brief Number of chunks.
+            size_t numChunks_ = 0;
+            /// @brief Chunk currently receiving records.
+            size_t fillChunk_ = 0;
+            /// @brief Oldest chunk waiting to be written.
+            size_t writeChunk_ = 0;
+            /// @brief Number of sealed chunks waiting to be written.
+            size_t sealedChunks_ = 0;
+            /// @brief Time the current chunk received its first record.
+            int64_t fillChunkStart_ = 0;
+            /// @brief Max time a partly filled chunk waits before being written.
+            int64_t maxChunkAge_ = 0;
+            /// @brief Number of records dropped due to no free chunk.
+            size_t droppedRecords_ = 0;
+            /// @brief Number of records recorded.
+            size_t numRecords_ = 0;
+            /// @brief Number of chunks that could not be completely written to storage.
+            size_t writeErrors_ = 0;
+            /// @brief If the file header has been written.
+            bool headerWritten_ = false;
+
+        public:
+            /**
+             * @param storage Where to write the log to.
+             * @param chunkSize Max payload size of a chunk in bytes. Larger chunks mean fewer, larger writes.
+             * @param numChunks Number of chunks in ram. Must be at least 2 to allow recording while writing.
+             * @param flushInterval_ns How often the writer task checks for chunks to write.
+             * @param maxChunkAge_ns Max time a partly filled chunk is held in ram before being written.
+             */
+            DataLog_Writer(DataLog_Storage &storage, size_t chunkSize = 4096, size_t numChunks = 4, int64_t flushInterval_ns = 100 * MILLISECONDS, int64_t maxChunkAge_ns = 1 * SECONDS);
+
+            ~DataLog_Writer();
+
+            /**
+             * @brief Copies a record into the current chunk.
+             * @note Does not block. If no chunk is free then the record is dropped.
+             * @param channel Channel the record belongs to. Used to seperate streams when replaying.
+             * @param timestamp Timestamp of the record in nanoseconds.
+             * @param data Pointer to record data.
+             * @param size Size of record data in bytes.
+             * @returns true if recorded, false if dropped.
+             */
+            bool record(uint16_t channel, int64_t timestamp, const void *data, uint16_t size);
+
+            /**
+             * @brief Seals the current chunk and writes all waiting chunks to storage. Blocks until written.
+             */
+            void flush();
+
+            /**
+             * @returns number of records dropped due to all chunks waiting to be written.
+             */
+            size_t getDroppedRecords() const;
+
+            /**
+             * @returns number of records successfully placed into chunks.
+             */
+            size_t getNumRecords() const;
+
+            /**
+             * @returns number of chunks that storage failed to completely write.
+             */
+            size_t getWriteErrors() const;
+
+            /**
+             * @brief Writes waiting chunks to storage. Called by the scheduler.
+             */
+            void taskThread() override;
+
+        private:
+            /**
+             * @returns pointer to the payload of the given chunk.
+             */
+            uint8_t *getPayload(size_t chunk);
+
+            /**
+             * @brief Marks the current chunk as ready to be written and moves on to the next.
+             * @returns false if there is no free chunk to move to.
+             */
+            bool sealChunk();
+
+            /**
+             * @brief Writes all sealed chunks to storage.
+             */
+            void writeSealedChunks();
+        };
+
+        /**
+         * @brief Index entry of a chunk inside a log.
+         */
+        struct DataLog_ChunkIndex
+        {
+            /// @brief Position of the chunk header in storage.
+            size_t position = 0;
+            /// @brief Header of the chunk.
+            DataLog_ChunkHeader header;
+        };
+
+        /**
+         * @brief Reads a log created by DataLog_Writer. Builds a time index of all chunks on open().
+         */
+        class DataLog_Reader
+        {
+        private:
+            /// @brief Storage to read from.
+            DataLog_Storage *storage_ = nullptr;
+            /// @brief Index of all chunks found in storage.
+            ListArray<DataLog_ChunkIndex> chunkIndex_;
+            /// @brief Payload of the currently loaded chunk.
+            ListArray<uint8_t> payload_;
+            /// @brief Index of the chunk records are read from.
+            size_t currentChunk_ = 0;
+            /// @brief If the payload of the current chunk is loaded.
+            bool chunkLoaded_ = false;
+            /// @brief Read position in payload of current chunk.
+            size_t payloadPos_ = 0;
+            /// @brief Number of chunks that failed the CRC check.
+            size_t crcErrors_ = 0;
+
+        public:
+            DataLog_Reader(DataLog_Storage &storage);
+
+            /**
+             * @brief Checks the file header and scans all chunk headers to build the time index.
+             * @note A chunk cut short by e.g. a power loss ends the index. So does a chunk header with a payload size larger than
+             * the writers chunk size or the rest of the storage, as its header is corrupted and the following chunks cannot be found.
+             * @returns false if storage does not contain a data log.
+             */
+            bool open();
+
+            /**
+             * @returns the list of all chunks found in log.
+             */
+            const List<DataLog_ChunkIndex> &getChunkIndex() const;
+
+            /**
+             * @returns the timestamp of the first record. 0 if log is empty.
+             */
+            int64_t getStartTime() const;
+
+            /**
+             * @returns the timestamp of the last record. 0 if log is empty.
+             */
+            int64_t getEndTime() const;
+
+            /**
+             * @brief Moves to the first chunk containing records at or after the given time. O(log n) time complexity.
+             * @param timestamp Time to seek to in nanoseconds.
+             * @returns false if there are no records at or after given time.
+             */
+            bool seekTime(int64_t timestamp);
+
+            /**
+             * @brief Reads the next record. Chunks failing their CRC check are skipped.
+             * @param channel Is set to the channel of record.
+             * @param timestamp Is set to the timestamp of record.
+             * @param data Is set to point to the record data. Valid until next call.
+             * @param size Is set to the size of record data.
+             * @returns false if there are no more records.
+             */
+            bool nextRecord(uint16_t &channel, int64_t &timestamp, const uint8_t *&data, uint16_t &size);
+
+            /**
+             * @returns number of chunks skipped due to a failed CRC check.
+             */
+            size_t getCrcErrors() const;
+
+        private:
+            /**
+             * @brief Loads the payload of given chunk and checks its CRC.
+             */
+            bool loadChunk(size_t chunk);
+        };
+
+        /**
+         * @brief Interface class for receiving records of a given channel from DataLog_Replayer.
+         */
+        class DataLog_Replay_Channel
+        {
+            friend class DataLog_Replayer;
+
+        private:
+            /// @brief Channel this replays.
+            uint16_t channel_ = 0;
+
+        public:
+            virtual ~DataLog_Replay_Channel() {}
+
+            /**
+             * @returns the channel this receives.
+             */
+            uint16_t getChannel() const { return channel_; }
+
+        protected:
+            DataLog_Replay_Channel(uint16_t channel) : channel_(channel) {}
+
+            /**
+             * @brief Called by replayer for each record in this channel.
+             */
+            virtual void replay(int64_t timestamp, const uint8_t *data, uint16_t size) = 0;
+        };
+
+        /**
+         * @brief Task replaying a log into topics at original, scaled or max speed.
+         * Records are given to the DataLog_Replay_Channel of the same channel, records without a channel are skipped.
+         */
+        class DataLog_Replayer : public Scheduler::Task
+        {
+        private:
+            /// @brief Reader of the log.
+            DataLog_Reader *reader_ = nullptr;
+            /// @brief Channels to give records to.
+            ListArray<DataLog_Replay_Channel *> channels_;
+            /// @brief Replay speed. 1 is original speed, 0 is max speed.
+            float speed_ = 1;
+            /// @brief Max number of records replayed per task run in max speed mode.
+            size_t maxRecordsPerRun_ = 0;
+            /// @brief Log time replay was started at.
+            int64_t logStart_ = 0;
+            /// @brief Time replay was started at.
+            int64_t replayStart_ = 0;
+            /// @brief If the replayer is currently running.
+            bool running_ = false;
+            /// @brief If a record has been read but not yet replayed.
+            bool pending_ = false;
+            /// @brief The record waiting to be replayed.
+            uint16_t pendingChannel_ = 0;
+            int64_t pendingTimestamp_ = 0;
+            const uint8_t *pendingData_ = nullptr;
+            uint16_t pendingSize_ = 0;
+
+        public:
+            /**
+             * @param reader Log to replay. Must be opened.
+             * @param speed Replay speed. 1 is original speed, 2 twice as fast. 0 will replay as fast as possible.
+             * @param maxRecordsPerRun Max records replayed per task run. Stops a large or fast log from blocking other tasks.
+             */
+            DataLog_Replayer(DataLog_Reader &reader, float speed = 1, size_t maxRecordsPerRun = 256);
+
+            /**
+             * @brief Adds a channel to give records to.
+             */
+            void addChannel(DataLog_Replay_Channel &channel);
+
+            /**
+             * @brief Removes the given channel.
+             */
+            void removeChannel(DataLog_Replay_Channel &channel);
+
+            /**
+             * @brief Sets the replay speed. 1 is original speed. 0 will replay as fast as possible.
+             */
+            void setSpeed(float speed);
+
+            /**
+             * @returns the replay speed.
+             */
+            float getSpeed() const;
+
+            /**
+             * @brief Starts replaying from the given log time.
+             * @param logTime Log timestamp to start at. Defaults to start of log.
+             * @returns false if there is nothing to replay.
+             */
+            bool start(int64_t logTime = 0);
+
+            /**
+             * @brief Stops replaying.
+             */
+            void stop();
+
+            /**
+             * @returns true if currently replaying.
+             */
+            bool isRunning() const;
+
+            /**
+             * @brief Plans the next run for when the next record is due.
+             */
+            void taskCheck() override;
+
+            /**
+             * @brief Replays all records that are due.
+             */
+            void taskThread() override;
+
+        private:
+            /**
+             * @returns the time the given log timestamp should be replayed at.
+             */
+            int64_t getReplayTime(int64_t timestamp) const;
+
+            /**
+             * @brief Gives the pending record to its channel.
+             */
+            void replayPending();
+        };
+
+        /**
+         * @brief Records the items of a timestamped topic into a DataLog_Writer.
+         * @tparam TYPE Data type of topic. Must be trivially copyable as it is stored as raw bytes.
+         */
+        template <typename TYPE>
+        class Topic_Recorder : public Subscriber<Timestamped<TYPE>>
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Topic_Recorder requires a trivially copyable type.");
+            static_assert(sizeof(TYPE) <= UINT16_MAX, "Type too large to be recorded.");
+
+        private:
+            DataLog_Writer *writer_ = nullptr;
+            uint16_t channel_ = 0;
+
+        public:
+            /**
+             * @param writer Writer to record into.
+             * @param channel Channel to record items under.
+             */
+            Topic_Recorder(DataLog_Writer &writer, uint16_t channel) : writer_(&writer), channel_(channel) {}
+
+            /**
+             * @param writer Writer to record into.
+             * @param channel Channel to record items under.
+             * @param topic Topic to record.
+             */
+            Topic_Recorder(DataLog_Writer &writer, uint16_t channel, Topic<Timestamped<TYPE>> &topic) : writer_(&writer), channel_(channel)
+            {
+                this->subscribe(topic);
+            }
+
+        private:
+            void receive(const Timestamped<TYPE> &item, const Topic<Timestamped<TYPE>> *topic) override
+            {
+                writer_->record(channel_, item.timestamp, &item.data, sizeof(TYPE));
+            }
+        };
+
+        /**
+         * @brief Records the items of a topic of any type into a log. Records are timestamped with the time of recording.
+         * Trivially copyable items are recorded directly, other types are serialized. @see Topic_Serializer
+         * @tparam MAXSIZE Max size of serialized items in bytes. Only used for types that are not trivially copyable.
+         */
+        template <size_t MAXSIZE = 256>
+        class Topic_Raw_Recorder : public Topic_Raw_Subscriber
+        {
+        private:
+            DataLog_Writer *writer_ = nullptr;
+            uint16_t channel_ = 0;
+
+        public:
+            /**
+             * @param writer Writer to record into.
+             * @param channel Channel to record items under.
+             */
+            Topic_Raw_Recorder(DataLog_Writer &writer, uint16_t channel) : writer_(&writer), channel_(channel) {}
+
+            /**
+             * @param writer Writer to record into.
+             * @param channel Channel to record items under.
+             * @param topic Topic to record.
+             */
+            Topic_Raw_Recorder(DataLog_Writer &writer, uint16_t channel, const Topic_Handle &topic) : writer_(&writer), channel_(channel)
+            {
+                this->subscribe(topic);
+            }
+
+        protected:
+            void receiveRaw(const void *item, const Topic_Handle &topic) override
+            {
+                if (topic.isTrivial())
+                {
+                    if (topic.getItemSize() <= UINT16_MAX)
+                        writer_->record(channel_, NOW(), item, uint16_t(topic.getItemSize()));
+                    return;
+                }
+
+                uint8_t buffer[MAXSIZE];
+                size_t size = topic.serialize(item, buffer, MAXSIZE);
+                if (size > 0 && size <= UINT16_MAX)
+                    writer_->record(channel_, NOW(), buffer, uint16_t(size));
+            }
+        };
+
+        /**
+         * @brief Publishes records of a channel into a timestamped topic. Records keep their original timestamp.
+         * @tparam TYPE Data type of topic. Must be the type the channel was recorded with.
+         */
+        template <typename TYPE>
+        class Topic_Replay_Channel : public DataLog_Replay_Channel
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Topic_Replay_Channel requires a trivially copyable type.");
+
+        private:
+            Topic<Timestamped<TYPE>> *topic_ = nullptr;
+            size_t sizeMismatches_ = 0;
+
+        public:
+            /**
+             * @param channel Channel to replay.
+             * @param topic Topic to publish records to.
+             */
+            Topic_Replay_Channel(uint16_t channel, Topic<Timestamped<TYPE>> &topic) : DataLog_Replay_Channel(channel), topic_(&topic) {}
+
+            /**
+             * @param replayer Replayer to add channel to.
+             * @param channel Channel to replay.
+             * @param topic Topic to publish records to.
+             */
+            Topic_Replay_Channel(DataLog_Replayer &replayer, uint16_t channel, Topic<Timestamped<TYPE>> &topic) : DataLog_Replay_Channel(channel), topic_(&topic)
+            {
+                replayer.addChannel(*this);
+            }
+
+            /**
+             * @returns number of records skipped due to their size not matching TYPE.
+             */
+            size_t getSizeMismatches() const { return sizeMismatches_; }
+
+        protected:
+            void replay(int64_t timestamp, const uint8_t *data, uint16_t size) override
+            {
+                if (size != sizeof(TYPE))
+                {
+                    sizeMismatches_++;
+                    return;
+                }
+
+                Timestamped<TYPE> item(timestamp);
+                memcpy(&item.data, data, sizeof(TYPE));
+                topic_->publish(item);
+            }
+        };
+
+    }
+
+}
+
+#endif
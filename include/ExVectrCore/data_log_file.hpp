@@ -0,0 +1,70 @@
+#ifndef EXVECTRCORE_DATALOGFILE_HPP
+#define EXVECTRCORE_DATALOGFILE_HPP
+
+#include "stddef.h"
+#include "stdio.h"
+
+#include "data_log.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Data log storage using a file through the C standard library.
+         * @note Only for platforms with a file system supporting fopen().
+         */
+        class DataLog_File : public DataLog_Storage
+        {
+        private:
+            /// @brief Opened file. nullptr if not open.
+            FILE *file_ = nullptr;
+
+        public:
+            DataLog_File();
+
+            /**
+             * @brief Opens the given file.
+             * @param path Path to the file.
+             * @param write If true the file is created or cleared for writing a new log. Otherwise opened for reading.
+             */
+            DataLog_File(const char *path, bool write);
+
+            ~DataLog_File();
+
+            /**
+             * @brief Opens the given file. Closes any previously opened file.
+             * @param path Path to the file.
+             * @param write If true the file is created or cleared for writing a new log. Otherwise opened for reading.
+             * @returns true if opened.
+             */
+            bool open(const char *path, bool write);
+
+            /**
+             * @brief Closes the file.
+             */
+            void close();
+
+            /**
+             * @returns true if a file is open.
+             */
+            bool isOpen() const;
+
+            size_t write(const void *data, size_t size) override;
+
+            size_t read(void *data, size_t size) override;
+
+            bool seek(size_t position) override;
+
+            size_t position() const override;
+
+            void flush() override;
+        };
+
+    }
+
+}
+
+#endif
@@ -4,6 +4,9 @@
 #include "stddef.h"
 #include "stdint.h"
 
+#include <iterator>
+#include <type_traits>
+
 namespace VCTR
 {
 
@@ -13,6 +16,52 @@ namespace VCTR
         template <typename TYPE>
         class EmptyList;
 
+        /**
+         * @brief Iterator over any List using its index operator. Allows range-for and standard algorithms on a List reference.
+         * Each access is a virtual call, use the begin() and end() of the concrete list type where possible, as these are plain pointers or non virtual.
+         * @tparam LISTTYPE List<TYPE> or const List<TYPE>.
+         * @tparam TYPE TYPE or const TYPE.
+         */
+        template <typename LISTTYPE, typename TYPE>
+        class List_Iterator
+        {
+        private:
+            LISTTYPE *list_ = nullptr;
+            size_t index_ = 0;
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef typename std::remove_const<TYPE>::type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef TYPE *pointer;
+            typedef TYPE &reference;
+
+            List_Iterator() {}
+
+            List_Iterator(LISTTYPE *list, size_t index) : list_(list), index_(index) {}
+
+            TYPE &operator*() const { return (*list_)[index_]; }
+
+            TYPE *operator->() const { return &(*list_)[index_]; }
+
+            List_Iterator &operator++()
+            {
+                index_++;
+                return *this;
+            }
+
+            List_Iterator operator++(int)
+            {
+                List_Iterator copy = *this;
+                index_++;
+                return copy;
+            }
+
+            bool operator==(const List_Iterator &other) const { return index_ == other.index_ && list_ == other.list_; }
+
+            bool operator!=(const List_Iterator &other) const { return !(*this == other); }
+        };
+
         /**
          * This is a abstract class for defining the interface for different list data types. Some examples are list array, list fixed.
          * Each different type has its pros and cons and different behaviors.
@@ -62,6 +111,17 @@ namespace VCTR
              */
             virtual const TYPE &operator()(int32_t index) const;
 
+            /**
+             * @brief Iterators for range-for over any list. Hidden by faster versions in lists with contiguous storage.
+             */
+            List_Iterator<List<TYPE>, TYPE> begin() { return List_Iterator<List<TYPE>, TYPE>(this, 0); }
+
+            List_Iterator<List<TYPE>, TYPE> end() { return List_Iterator<List<TYPE>, TYPE>(this, size()); }
+
+            List_Iterator<const List<TYPE>, const TYPE> begin() const { return List_Iterator<const List<TYPE>, const TYPE>(this, 0); }
+
+            List_Iterator<const List<TYPE>, const TYPE> end() const { return List_Iterator<const List<TYPE>, const TYPE>(this, size()); }
+
             /**
              * @brief   Will copy the items in the given list into the list. The number of items to be copied is the size of the smaller array.
              *          This is usually the size of the array being copied but can be limited by the copying array if its a fixed size and smaller.
@@ -0,0 +1,340 @@
+#ifndef EXVECTRCORE_LISTALGORITHMS_HPP
+#define EXVECTRCORE_LISTALGORITHMS_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Algorithms over plain arrays, e.g. from ListArray::span() or ListBuffer::getSegments().
+         * None of them recurse or allocate, so they are safe on small stacks.
+         */
+
+        /**
+         * @brief Sorts first, middle and last so that first holds the smallest and middle the median of the three.
+         */
+        template <typename T>
+        void medianOfThree(T &first, T &middle, T &last)
+        {
+            if (middle < first)
+                std::swap(first, middle);
+            if (last < middle)
+            {
+                std::swap(middle, last);
+                if (middle < first)
+                    std::swap(first, middle);
+            }
+        }
+
+        /**
+         * @brief Partitions data[left] to data[right] around a median of three pivot. Needs at least 4 elements.
+         * @returns index of the pivot. All elements before are not greater, all after not smaller. Always between left and right exclusive.
+         */
+        template <typename T>
+        size_t partitionMedianOfThree(T *data, size_t left, size_t right)
+        {
+            // Pivot ends up at right - 1, with sentinels at left and right.
+            size_t middle = left + (right - left) / 2;
+            medianOfThree(data[left], data[middle], data[right]);
+            std::swap(data[middle], data[right - 1]);
+            const T &pivot = data[right - 1];
+
+            size_t i = left;
+            size_t j = right - 1;
+            while (true)
+            {
+                while (data[++i] < pivot)
+                    ;
+                while (pivot < data[--j])
+                    ;
+                if (i >= j)
+                    break;
+                std::swap(data[i], data[j]);
+            }
+            std::swap(data[i], data[right - 1]);
+
+            return i;
+        }
+
+        /**
+         * @brief Reverses the order of elements.
+         */
+        template <typename T>
+        void reverseElements(T *data, size_t size)
+        {
+            for (size_t i = 0; i < size / 2; i++)
+                std::swap(data[i], data[size - 1 - i]);
+        }
+
+        /**
+         * @brief Sorts data in ascending order. O(size^2), but fastest for few or almost sorted elements.
+         */
+        template <typename T>
+        void sortInsertion(T *data, size_t size)
+        {
+            for (size_t i = 1; i < size; i++)
+            {
+                if (!(data[i] < data[i - 1]))
+                    continue;
+
+                T value = std::move(data[i]);
+                size_t j = i;
+                do
+                {
+                    data[j] = std::move(data[j - 1]);
+                    j--;
+                } while (j > 0 && value < data[j - 1]);
+                data[j] = std::move(value);
+            }
+        }
+
+        /**
+         * @brief Moves the element at position down the max heap data until its children are not greater.
+         */
+        template <typename T>
+        void heapSiftDown(T *data, size_t size, size_t position)
+        {
+            T value = std::move(data[position]);
+
+            while (true)
+            {
+                size_t child = 2 * position + 1;
+                if (child >= size)
+                    break;
+                if (child + 1 < size && data[child] < data[child + 1])
+                    child++;
+                if (!(value < data[child]))
+                    break;
+                data[position] = std::move(data[child]);
+                position = child;
+            }
+
+            data[position] = std::move(value);
+        }
+
+        /**
+         * @brief Sorts data in ascending order. O(size log size) in every case.
+         */
+        template <typename T>
+        void sortHeap(T *data, size_t size)
+        {
+            if (size < 2)
+                return;
+
+            for (size_t i = size / 2; i > 0; i--)
+                heapSiftDown(data, size, i - 1);
+
+            for (size_t end = size - 1; end > 0; end--)
+            {
+                std::swap(data[0], data[end]);
+                heapSiftDown(data, end, 0);
+            }
+        }
+
+        /**
+         * @brief Sorts data in ascending order using introsort: quicksort with median of three pivots, insertion sort for small ranges,
+         * and heapsort for ranges that partition badly. O(size log size) in every case, including already sorted data. Not stable.
+         * Uses a fixed size range stack instead of recursion.
+         * @param data Elements to sort.
+         * @param size Number of elements.
+         */
+        template <typename T>
+        void sortIntro(T *data, size_t size)
+        {
+            // Ranges of this size or smaller are insertion sorted.
+            const size_t insertionSize = 16;
+
+            struct Range
+            {
+                size_t left;
+                size_t right;
+                size_t depth;
+            };
+
+            if (size < 2)
+                return;
+
+            // Quicksort steps allowed before switching to heapsort.
+            size_t depthLimit = 0;
+            for (size_t n = size; n > 1; n >>= 1)
+                depthLimit += 2;
+
+            // The larger side is pushed and the smaller one sorted first, so there are never more than log2(size) ranges.
+            Range stack[sizeof(size_t) * 8];
+            size_t numRanges = 0;
+            stack[numRanges++] = Range{0, size - 1, depthLimit};
+
+            while (numRanges > 0)
+            {
+                Range range = stack[--numRanges];
+
+                while (range.right - range.left >= insertionSize && range.depth > 0)
+                {
+                    range.depth--;
+                    size_t p = partitionMedianOfThree(data, range.left, range.right);
+
+                    if (p - range.left < range.right - p)
+                    {
+                        stack[numRanges++] = Range{p + 1, range.right, range.depth};
+                        range.right = p - 1;
+                    }
+                    else
+                    {
+                        stack[numRanges++] = Range{range.left, p - 1, range.depth};
+                        range.left = p + 1;
+                    }
+                }
+
+                if (range.right - range.left >= insertionSize)
+                    sortHeap(data + range.left, range.right - range.left + 1);
+                else
+                    sortInsertion(data + range.left, range.right - range.left + 1);
+            }
+        }
+
+        /**
+         * @brief Unsigned integer with the given number of bytes.
+         */
+        template <size_t BYTES>
+        struct Radix_Unsigned;
+
+        template <>
+        struct Radix_Unsigned<1>
+        {
+            typedef uint8_t type;
+        };
+
+        template <>
+        struct Radix_Unsigned<2>
+        {
+            typedef uint16_t type;
+        };
+
+        template <>
+        struct Radix_Unsigned<4>
+        {
+            typedef uint32_t type;
+        };
+
+        template <>
+        struct Radix_Unsigned<8>
+        {
+            typedef uint64_t type;
+        };
+
+        /**
+         * @returns unsigned key of value that sorts in the same order as value.
+         * Signed integers get their sign bit flipped. Floats have all bits flipped if negative, otherwise only the sign bit.
+         */
+        template <typename T>
+        typename Radix_Unsigned<sizeof(T)>::type radixKey(const T &value)
+        {
+            typedef typename Radix_Unsigned<sizeof(T)>::type Key;
+            const Key signBit = Key(Key(1) << (sizeof(T) * 8 - 1));
+
+            Key key;
+            memcpy(&key, &value, sizeof(T));
+
+            if (std::is_floating_point<T>::value)
+                return (key & signBit) ? Key(~key) : Key(key | signBit);
+            if (std::is_signed<T>::value)
+                return Key(key ^ signBit);
+            return key;
+        }
+
+        /**
+         * @brief Sorts integers or floats in ascending order using least significant byte first radix sort. O(size), stable.
+         * Passes over bytes that are the same in all elements are skipped.
+         * @param data Elements to sort.
+         * @param scratch Memory for at least size elements. Contents are overwritten.
+         * @param size Number of elements.
+         */
+        template <typename T>
+        void sortRadix(T *data, T *scratch, size_t size)
+        {
+            static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "Radix sort needs integer or float keys of up to 8 bytes.");
+
+            if (size < 2)
+                return;
+
+            T *source = data;
+            T *destination = scratch;
+
+            for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8)
+            {
+                size_t counts[256] = {};
+                for (size_t i = 0; i < size; i++)
+                    counts[(radixKey(source[i]) >> shift) & 0xFF]++;
+
+                // Order would not change.
+                if (counts[(radixKey(source[0]) >> shift) & 0xFF] == size)
+                    continue;
+
+                size_t offset = 0;
+                for (size_t &count : counts)
+                {
+                    size_t bucketSize = count;
+                    count = offset;
+                    offset += bucketSize;
+                }
+
+                for (size_t i = 0; i < size; i++)
+                    destination[counts[(radixKey(source[i]) >> shift) & 0xFF]++] = source[i];
+
+                std::swap(source, destination);
+            }
+
+            if (source != data)
+                memcpy(static_cast<void *>(data), static_cast<const void *>(source), size * sizeof(T));
+        }
+
+        /**
+         * @brief Partially sorts data so the element at index n is the one that would be there if sorted,
+         * all elements before it are not greater and all after are not smaller. Same as std::nth_element.
+         * Quickselect with median of three pivots, O(size) on average.
+         * @param data Elements to select from. Reordered.
+         * @param size Number of elements.
+         * @param n Index of element to select. Does nothing if not below size.
+         */
+        template <typename T>
+        void selectNth(T *data, size_t size, size_t n)
+        {
+            if (n >= size)
+                return;
+
+            size_t left = 0;
+            size_t right = size - 1;
+
+            while (right - left > 2)
+            {
+                size_t i = partitionMedianOfThree(data, left, right);
+
+                if (n == i)
+                    return;
+                if (n < i)
+                    right = i - 1;
+                else
+                    left = i + 1;
+            }
+
+            // At most three elements left.
+            if (right - left == 2)
+                medianOfThree(data[left], data[left + 1], data[right]);
+            else if (right > left && data[right] < data[left])
+                std::swap(data[left], data[right]);
+        }
+
+    }
+
+}
+
+#endif
@@ -2,8 +2,15 @@
 #define EXVECTRCORE_LISTARRAY_H
 
 #include "stddef.h"
+#include "string.h"
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
 #include "list.hpp"
+#include "list_span.hpp"
 
 namespace VCTR
 {
@@ -15,43 +22,71 @@ namespace VCTR
          * This is a dynamic array. If full, the size will be doubled. Uses heap memory and can be slower. Iterating through list is fast and item access is O(1). Removing or adding an item is O(n).
          * The next item index is always +1. So the same as a normal array.
          * The sizeControl setting on construction can cause heap fragmentation if set to true but will reduce size if unneeded
+         * Storage is only allocated once the first item is added. Items only exist up to size(), so TYPE does not need to be default constructible
+         * and growing moves items instead of copying them. Trivially copyable types are grown with realloc.
+         * Memory comes from the given Allocator, the global heap by default. Functions adding items return false if it runs out of memory, the list is then unchanged.
          * @param TYPE type of data to store in ListArray
          */
         template <typename TYPE>
         class ListArray : public List<TYPE>
         {
         private:
+            /// @brief Trivially copyable items can be moved with memcpy and grown with realloc.
+            typedef std::integral_constant<bool, std::is_trivially_copyable<TYPE>::value> Trivial;
+
             // Current max size.
             size_t maxSize_ = 0;
 
             // Current size
             size_t size_ = 0;
 
-            // Pointer to start of array.
+            // Pointer to start of array. Uninitialized storage for maxSize_ items, of which the first size_ are constructed.
             TYPE *array_ = nullptr;
 
             // Whether to reduce array size automatically.
             bool sizeControl_ = false;
 
+            // Where the internal array is allocated from.
+            Allocator *allocator_;
+
+            // Storage inside the object used before going to the allocator. Only set by ListSmall.
+            TYPE *inlineArray_ = nullptr;
+
+            // Number of items fitting into inlineArray_. The internal array never gets smaller than this.
+            size_t inlineSize_ = 0;
+
         public:
             /**
              * @param sizeControl if set to true then the ListArray will automatically reduce the internal size to save space. Setting this to false will reduce heap fragmentation. Defaults to false.
              */
-            ListArray(bool sizeControl = false)
+            ListArray(bool sizeControl = false) : allocator_(&getHeapAllocator())
+            {
+                sizeControl_ = sizeControl;
+            }
+
+            /**
+             * @param allocator Allocator to take memory from. Must outlive this ListArray.
+             * @param sizeControl if set to true then the ListArray will automatically reduce the internal size to save space. Defaults to false.
+             */
+            ListArray(Allocator &allocator, bool sizeControl = false) : allocator_(&allocator)
             {
                 sizeControl_ = sizeControl;
-                array_ = new TYPE[1];
-                maxSize_ = 1;
             }
 
+            ListArray(const ListArray &other);
+
+            ListArray(ListArray &&other);
+
             ~ListArray()
             {
-                if (array_ != nullptr)
-                {
-                    delete[] array_;
-                }
+                clearItems();
+                freeArray(array_, maxSize_);
             }
 
+            ListArray &operator=(const ListArray &other);
+
+            ListArray &operator=(ListArray &&other);
+
             /**
              * @brief Current length of the array.
              */
@@ -63,15 +98,60 @@ namespace VCTR
             size_t getInternalArrayLength() const;
 
             /**
-             * @returns internal array pointer.
+             * @returns internal array pointer. nullptr if nothing was allocated yet.
              */
             const TYPE *getPtr() const;
 
+            /**
+             * @returns the allocator the internal array is allocated from.
+             */
+            Allocator &getAllocator() const;
+
+            /**
+             * @returns a view of the elements. Invalidated when the ListArray grows or shrinks.
+             */
+            ListSpan<TYPE> span();
+
+            /**
+             * @returns a read only view of the elements. Invalidated when the ListArray grows or shrinks.
+             */
+            ListSpan<const TYPE> span() const;
+
+            TYPE *begin() { return array_; }
+
+            TYPE *end() { return array_ + size_; }
+
+            const TYPE *begin() const { return array_; }
+
+            const TYPE *end() const { return array_ + size_; }
+
+            /**
+             * Makes sure the internal array can hold at least the given number of items without growing.
+             * @param size Number of items to make space for.
+             * @returns false if out of memory.
+             */
+            bool reserve(size_t size);
+
             /**
              * Adds a copy of the given item to the ListArray.
              * @param item Item to add to ListArray.
+             * @returns false if out of memory.
+             */
+            bool append(const TYPE &item);
+
+            /**
+             * Moves the given item into the ListArray.
+             * @param item Item to add to ListArray.
+             * @returns false if out of memory.
              */
-            void append(const TYPE &item);
+            bool append(TYPE &&item);
+
+            /**
+             * Constructs a new item at the end of the ListArray from the given arguments.
+             * @returns pointer to the new item. nullptr if out of memory.
+             */
+            template <typename... ARGS>
+            TYPE *emplaceBack(ARGS &&...args);
 
             /**
              * Adds a copy of the given item to the ListArray only if there is no other equal item already in the ListArray.
@@ -81,12 +161,13 @@ namespace VCTR
             bool appendIfNotInListArray(const TYPE &item);
 
             /**
-             * @brief Places item into given index. All other items behind given index will be pushed down. If Index is larger than ListArray, then new items will NOT be instantiated.
+             * @brief Places item into given index. All other items behind given index will be pushed down. If Index is larger than ListArray, then the gap is filled with default constructed items.
              *
              * @param item Item to be placed at index
              * @param index Index at which to place item
+             * @returns false if out of memory.
              */
-            void insert(const TYPE &item, size_t index);
+            bool insert(const TYPE &item, size_t index);
 
             /**
              * Inserts copy of item into ListArray behind infront of the first larger item.
@@ -139,25 +220,156 @@ namespace VCTR
             List<TYPE> &operator=(const List<TYPE> &listB);
 
             /**
-             * This will cut down the size of the array if it is less than half full. Can cause heap fragmentation.
+             * This will cut down the size of the internal array to the number of items if it is less than half full. Can cause heap fragmentation.
              */
             void reduceSize();
 
             /**
              * @brief Changes the size of the array. If the new size is smaller than the current size, then the array will be truncated. If the new size is larger than the current size, then the array will be padded with default values.
              * @param size New size of array.
+             * @returns false if out of memory.
              */
-            void setSize(size_t size);
+            bool setSize(size_t size);
+
+        protected:
+            /**
+             * @brief Used by ListSmall to start out with storage inside the object.
+             * @param inlineArray Uninitialized storage for inlineSize items. Used until more items are needed.
+             * @param inlineSize Number of items fitting into inlineArray.
+             */
+            ListArray(TYPE *inlineArray, size_t inlineSize, Allocator &allocator, bool sizeControl);
+
+            /**
+             * Destroys all items without releasing the internal array.
+             */
+            void clearItems();
 
         private:
             /**
-             * Changes size to given parameter.
-             * Copies items to new array.
+             * Changes size of the internal array to given parameter.
+             * Moves items to new array, items past the new size are destroyed.
              * @param size Size to change to.
+             * @returns false if out of memory. Nothing is changed then.
+             */
+            bool changeSizeTo(size_t size);
+
+            /**
+             * Grows the internal array and constructs a new item at the end in one step.
+             * The item is constructed before the old items are released, so args may refer to items in this list.
+             */
+            template <typename... ARGS>
+            TYPE *growEmplaceBack(ARGS &&...args);
+
+            /**
+             * @returns new internal array size when growing to fit minSize items.
+             */
+            size_t grownSize(size_t minSize) const;
+
+            TYPE *allocateArray(size_t size);
+
+            void freeArray(TYPE *array, size_t size);
+
+            /**
+             * Moves num items from source to uninitialized destination and destroys the items at source.
+             */
+            static void relocate(TYPE *source, TYPE *destination, size_t num, std::true_type trivial);
+
+            static void relocate(TYPE *source, TYPE *destination, size_t num, std::false_type trivial);
+
+            /**
+             * Moves the internal array to a new array of given size. Items up to numItems are kept, the rest is destroyed.
+             * @returns the new array. nullptr if out of memory, the internal array is then unchanged.
              */
-            void changeSizeTo(size_t size);
+            TYPE *resizeArray(size_t numItems, size_t size, std::true_type trivial);
+
+            TYPE *resizeArray(size_t numItems, size_t size, std::false_type trivial);
         };
 
+        template <typename TYPE>
+        ListArray<TYPE>::ListArray(const ListArray &other) : allocator_(other.allocator_)
+        {
+            sizeControl_ = other.sizeControl_;
+            if (!reserve(other.size_))
+                return;
+
+            for (size_t i = 0; i < other.size_; i++)
+                new (array_ + i) TYPE(other.array_[i]);
+
+            size_ = other.size_;
+        }
+
+        template <typename TYPE>
+        ListArray<TYPE>::ListArray(ListArray &&other) : allocator_(other.allocator_)
+        {
+            sizeControl_ = other.sizeControl_;
+            *this = std::move(other);
+        }
+
+        template <typename TYPE>
+        ListArray<TYPE>::ListArray(TYPE *inlineArray, size_t inlineSize, Allocator &allocator, bool sizeControl) : allocator_(&allocator)
+        {
+            sizeControl_ = sizeControl;
+            inlineArray_ = inlineArray;
+            inlineSize_ = inlineSize;
+            array_ = inlineArray;
+            maxSize_ = inlineSize;
+        }
+
+        template <typename TYPE>
+        ListArray<TYPE> &ListArray<TYPE>::operator=(const ListArray &other)
+        {
+
+            if (this == &other)
+                return *this;
+
+            clearItems();
+            if (!reserve(other.size_))
+                return *this;
+
+            for (size_t i = 0; i < other.size_; i++)
+                new (array_ + i) TYPE(other.array_[i]);
+
+            size_ = other.size_;
+
+            return *this;
+        }
+
+        template <typename TYPE>
+        ListArray<TYPE> &ListArray<TYPE>::operator=(ListArray &&other)
+        {
+
+            if (this == &other)
+                return *this;
+
+            clearItems();
+
+            // Items in the others inline storage can not be taken over, only moved.
+            if (other.array_ == nullptr || other.array_ == other.inlineArray_)
+            {
+                if (!reserve(other.size_))
+                    return *this;
+
+                relocate(other.array_, array_, other.size_, Trivial());
+                size_ = other.size_;
+                other.size_ = 0;
+
+                return *this;
+            }
+
+            freeArray(array_, maxSize_);
+
+            allocator_ = other.allocator_;
+            array_ = other.array_;
+            size_ = other.size_;
+            maxSize_ = other.maxSize_;
+
+            other.array_ = other.inlineArray_;
+            other.size_ = 0;
+            other.maxSize_ = other.inlineSize_;
+
+            return *this;
+        }
+
         template <typename TYPE>
         void ListArray<TYPE>::reduceSize()
         {
@@ -165,44 +377,160 @@ namespace VCTR
             if (size_ > maxSize_ / 2)
                 return;
 
-            size_t newSize = size_ / 2;
-
-            changeSizeTo(newSize);
+            changeSizeTo(size_);
         }
 
         template <typename TYPE>
-        void ListArray<TYPE>::setSize(size_t size)
+        bool ListArray<TYPE>::setSize(size_t size)
         {
 
-            changeSizeTo(size);
-            size_ = size;
+            if (!changeSizeTo(size))
+                return false;
+
+            for (; size_ < size; size_++)
+                new (array_ + size_) TYPE();
+
+            return true;
         }
 
         template <typename TYPE>
-        void ListArray<TYPE>::changeSizeTo(size_t size)
+        bool ListArray<TYPE>::changeSizeTo(size_t size)
         {
 
+            // Never smaller than the inline storage
+            if (size < inlineSize_)
+                size = inlineSize_;
+
             // Leave if already same size
             if (size == maxSize_)
-                return;
+                return true;
+
+            // Items that do not fit are dropped
+            size_t numItems = size_ < size ? size_ : size;
+
+            TYPE *newArray = resizeArray(numItems, size, Trivial());
+            if (newArray == nullptr && size > 0)
+                return false;
+
+            array_ = newArray;
+            maxSize_ = size;
+            size_ = numItems;
 
-            // Create new array
-            TYPE *newPointer = new TYPE[size];
+            return true;
+        }
 
-            // Move contents to new array
-            size_t i;
-            for (i = 0; i < size_ && i < size; i++)
+        template <typename TYPE>
+        template <typename... ARGS>
+        TYPE *ListArray<TYPE>::growEmplaceBack(ARGS &&...args)
+        {
+
+            size_t newSize = grownSize(size_ + 1);
+
+            if (Trivial::value)
             {
-                newPointer[i] = array_[i];
+                // Construct first, as args may point into the array realloc will release.
+                TYPE item(std::forward<ARGS>(args)...);
+                if (!changeSizeTo(newSize))
+                    return nullptr;
+                new (array_ + size_) TYPE(std::move(item));
             }
+            else
+            {
+                TYPE *newArray = allocateArray(newSize);
+                if (newArray == nullptr)
+                    return nullptr;
+                new (newArray + size_) TYPE(std::forward<ARGS>(args)...);
 
-            // Unallocate old array
-            delete[] array_;
+                relocate(array_, newArray, size_, Trivial());
+                freeArray(array_, maxSize_);
 
-            // Switch to new array and params
-            array_ = newPointer;
-            maxSize_ = size;
-            size_ = i;
+                array_ = newArray;
+                maxSize_ = newSize;
+            }
+
+            return &array_[size_++];
+        }
+
+        template <typename TYPE>
+        size_t ListArray<TYPE>::grownSize(size_t minSize) const
+        {
+
+            // Double size until large enough
+            size_t newSize = maxSize_ == 0 ? 1 : maxSize_;
+            while (newSize < minSize)
+                newSize *= 2;
+
+            return newSize;
+        }
+
+        template <typename TYPE>
+        void ListArray<TYPE>::clearItems()
+        {
+
+            for (size_t i = 0; i < size_; i++)
+                array_[i].~TYPE();
+
+            size_ = 0;
+        }
+
+        template <typename TYPE>
+        TYPE *ListArray<TYPE>::allocateArray(size_t size)
+        {
+            if (size <= inlineSize_)
+                return inlineArray_;
+
+            return size == 0 ? nullptr : static_cast<TYPE *>(allocator_->allocate(size * sizeof(TYPE), alignof(TYPE)));
+        }
+
+        template <typename TYPE>
+        void ListArray<TYPE>::freeArray(TYPE *array, size_t size)
+        {
+            if (array != inlineArray_)
+                allocator_->deallocate(array, size * sizeof(TYPE));
+        }
+
+        template <typename TYPE>
+        void ListArray<TYPE>::relocate(TYPE *source, TYPE *destination, size_t num, std::true_type)
+        {
+            if (num > 0)
+                memcpy(static_cast<void *>(destination), static_cast<const void *>(source), num * sizeof(TYPE));
+        }
+
+        template <typename TYPE>
+        void ListArray<TYPE>::relocate(TYPE *source, TYPE *destination, size_t num, std::false_type)
+        {
+            for (size_t i = 0; i < num; i++)
+            {
+                new (destination + i) TYPE(std::move(source[i]));
+                source[i].~TYPE();
+            }
+        }
+
+        template <typename TYPE>
+        TYPE *ListArray<TYPE>::resizeArray(size_t numItems, size_t size, std::true_type)
+        {
+            // Inline storage can not be reallocated.
+            if (inlineArray_ != nullptr && (array_ == inlineArray_ || size <= inlineSize_))
+                return resizeArray(numItems, size, std::false_type());
+
+            return static_cast<TYPE *>(allocator_->reallocate(array_, maxSize_ * sizeof(TYPE), size * sizeof(TYPE), alignof(TYPE)));
+        }
+
+        template <typename TYPE>
+        TYPE *ListArray<TYPE>::resizeArray(size_t numItems, size_t size, std::false_type)
+        {
+
+            TYPE *newArray = allocateArray(size);
+            if (newArray == nullptr && size > 0)
+                return nullptr;
+
+            relocate(array_, newArray, numItems, Trivial());
+            for (size_t i = numItems; i < size_; i++)
+                array_[i].~TYPE();
+
+            freeArray(array_, maxSize_);
+
+            return newArray;
         }
 
         template <typename TYPE>
@@ -224,18 +552,53 @@ namespace VCTR
         }
 
         template <typename TYPE>
-        void ListArray<TYPE>::append(const TYPE &item)
+        Allocator &ListArray<TYPE>::getAllocator() const
+        {
+            return *allocator_;
+        }
+
+        template <typename TYPE>
+        ListSpan<TYPE> ListArray<TYPE>::span()
+        {
+            return ListSpan<TYPE>(array_, size_);
+        }
+
+        template <typename TYPE>
+        ListSpan<const TYPE> ListArray<TYPE>::span() const
+        {
+            return ListSpan<const TYPE>(array_, size_);
+        }
+
+        template <typename TYPE>
+        bool ListArray<TYPE>::reserve(size_t size)
+        {
+            return size <= maxSize_ || changeSizeTo(size);
+        }
+
+        template <typename TYPE>
+        bool ListArray<TYPE>::append(const TYPE &item)
+        {
+            return emplaceBack(item) != nullptr;
+        }
+
+        template <typename TYPE>
+        bool ListArray<TYPE>::append(TYPE &&item)
+        {
+            return emplaceBack(std::move(item)) != nullptr;
+        }
+
+        template <typename TYPE>
+        template <typename... ARGS>
+        TYPE *ListArray<TYPE>::emplaceBack(ARGS &&...args)
         {
 
             // Double size if array is too small
-            if (maxSize_ == 0)
-                changeSizeTo(1);
-            else if (size_ >= maxSize_)
-                changeSizeTo(maxSize_ * 2);
+            if (size_ >= maxSize_)
+                return growEmplaceBack(std::forward<ARGS>(args)...);
 
-            array_[size_] = item;
+            new (array_ + size_) TYPE(std::forward<ARGS>(args)...);
 
-            size_++;
+            return &array_[size_++];
         }
 
         template <typename TYPE>
@@ -249,40 +612,41 @@ namespace VCTR
                     return false;
             }
 
-            append(item);
-
-            return true;
+            return append(item);
         }
 
         template <typename TYPE>
-        void ListArray<TYPE>::insert(const TYPE &item, size_t index)
+        bool ListArray<TYPE>::insert(const TYPE &item, size_t index)
         {
 
-            // Make sure the ListArray has a size
-            if (maxSize_ == 0)
-                changeSizeTo(1);
-
-            if (index >= maxSize_)
+            if (index >= size_)
             {
 
-                while (index >= maxSize_)
-                    changeSizeTo(maxSize_ * 2); // Inefficient but works. Should be changed to calculate the next largest exponent
-                size_ = index;
-                append(item);
+                if (!reserve(grownSize(index + 1)))
+                    return false;
+                for (; size_ < index; size_++)
+                    new (array_ + size_) TYPE();
+                return append(item);
             }
             else
             {
 
-                if (size_ >= maxSize_)
-                    changeSizeTo(maxSize_ * 2);
+                // Copy first, as item may be in the array that is about to be shifted.
+                TYPE newItem(item);
 
-                for (size_t i = size_; i > index; i--)
-                    array_[i] = array_[i - 1];
+                if (size_ >= maxSize_ && !changeSizeTo(grownSize(size_ + 1)))
+                    return false;
+
+                new (array_ + size_) TYPE(std::move(array_[size_ - 1]));
+                for (size_t i = size_ - 1; i > index; i--)
+                    array_[i] = std::move(array_[i - 1]);
 
-                array_[index] = item;
+                array_[index] = std::move(newItem);
 
                 size_++;
             }
+
+            return true;
         }
 
         template <typename TYPE>
@@ -294,10 +658,11 @@ namespace VCTR
 
             for (size_t i = index; i < size_ - 1; i++)
             {
-                array_[i] = array_[i + 1];
+                array_[i] = std::move(array_[i + 1]);
             }
 
             size_--;
+            array_[size_].~TYPE();
 
             if (sizeControl_ && size_ <= maxSize_ / 2)
                 changeSizeTo(maxSize_ / 2);
@@ -329,20 +694,30 @@ namespace VCTR
         size_t ListArray<TYPE>::removeAllEqual(const TYPE &item)
         {
 
-            size_t found = 0;
+            // Copy first, as item may be one of the items being removed.
+            TYPE toRemove(item);
 
-            // Find index of item
+            // Move all items to keep forward in one pass.
+            size_t kept = 0;
             for (size_t i = 0; i < size_; i++)
             {
 
-                if (array_[i] == item)
-                {
+                if (array_[i] == toRemove)
+                    continue;
 
-                    removeAtIndex(i);
-                    found++;
-                }
+                if (kept != i)
+                    array_[kept] = std::move(array_[i]);
+                kept++;
             }
 
+            size_t found = size_ - kept;
+
+            for (; size_ > kept; size_--)
+                array_[size_ - 1].~TYPE();
+
+            if (sizeControl_ && size_ <= maxSize_ / 2)
+                changeSizeTo(size_);
+
             return found;
         }
 
@@ -350,10 +725,10 @@ namespace VCTR
         void ListArray<TYPE>::clear()
         {
 
+            clearItems();
+
             if (sizeControl_)
                 changeSizeTo(0);
-            else
-                size_ = 0;
         }
 
         template <typename TYPE>
@@ -372,7 +747,11 @@ namespace VCTR
         List<TYPE> &ListArray<TYPE>::operator=(const List<TYPE> &listB)
         {
 
+            if (&listB == this)
+                return *this;
+
             clear();
+            reserve(listB.size());
 
             // Copy items into ListArray
             for (size_t i = 0; i < listB.size(); i++)
@@ -385,4 +764,4 @@ namespace VCTR
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -4,8 +4,20 @@
 #include "stdint.h"
 #include "stddef.h"
 #include "math.h"
+#include "string.h"
 
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
 #include "list.hpp"
+#include "list_algorithms.hpp"
+#include "list_reduce.hpp"
+#include "list_span.hpp"
+#include "running_statistics.hpp"
+#include "sliding_median.hpp"
 
 namespace VCTR
 {
@@ -13,14 +25,369 @@ namespace VCTR
     namespace Core
     {
 
+        /**
+         * @brief Iterates over a ListBuffer in index order, newest element first. Same order as ListBuffer::operator[], without its virtual call.
+         * @tparam T Type of elements. Const for a read only iterator.
+         */
+        template <typename T>
+        class ListBuffer_Iterator
+        {
+        private:
+            T *array_ = nullptr;
+            size_t arraySize_ = 0;
+            // Array index of current element.
+            size_t position_ = 0;
+            // Number of elements left including current. Iterators are equal if this is equal.
+            size_t remaining_ = 0;
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef typename std::remove_const<T>::type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef T *pointer;
+            typedef T &reference;
+
+            ListBuffer_Iterator() {}
+
+            ListBuffer_Iterator(T *array, size_t arraySize, size_t position, size_t remaining) : array_(array), arraySize_(arraySize), position_(position), remaining_(remaining) {}
+
+            T &operator*() const { return array_[position_]; }
+
+            T *operator->() const { return &array_[position_]; }
+
+            ListBuffer_Iterator &operator++()
+            {
+                position_ = position_ == 0 ? arraySize_ - 1 : position_ - 1;
+                remaining_--;
+                return *this;
+            }
+
+            ListBuffer_Iterator operator++(int)
+            {
+                ListBuffer_Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const ListBuffer_Iterator &other) const { return remaining_ == other.remaining_; }
+
+            bool operator!=(const ListBuffer_Iterator &other) const { return remaining_ != other.remaining_; }
+        };
+
+        /**
+         * @brief Default constructed elements from the heap allocator, freed on destruction. Used by ListBuffer for copies too large for the stack.
+         * @tparam T Type of elements.
+         */
+        template <typename T>
+        class ListBuffer_Scratch
+        {
+        private:
+            T *data_ = nullptr;
+            size_t size_ = 0;
+
+        public:
+            /**
+             * @param size Number of elements.
+             */
+            ListBuffer_Scratch(size_t size);
+
+            ~ListBuffer_Scratch();
+
+            ListBuffer_Scratch(const ListBuffer_Scratch &) = delete;
+
+            ListBuffer_Scratch &operator=(const ListBuffer_Scratch &) = delete;
+
+            /**
+             * @returns the elements. nullptr if size was 0 or out of memory.
+             */
+            T *data() const { return data_; }
+        };
+
+        template <typename T>
+        ListBuffer_Scratch<T>::ListBuffer_Scratch(size_t size)
+        {
+            if (size == 0)
+                return;
+
+            data_ = static_cast<T *>(getHeapAllocator().allocate(size * sizeof(T), alignof(T)));
+            if (data_ == nullptr)
+                return;
+
+            size_ = size;
+            for (size_t i = 0; i < size_; i++)
+                new (data_ + i) T();
+        }
+
+        template <typename T>
+        ListBuffer_Scratch<T>::~ListBuffer_Scratch()
+        {
+            if (data_ == nullptr)
+                return;
+
+            for (size_t i = 0; i < size_; i++)
+                data_[i].~T();
+            getHeapAllocator().deallocate(data_, size_ * sizeof(T));
+        }
+
+        /**
+         * @brief Optional ListBuffer features, selected at compile time by the FEATURES parameter. Combine with |.
+         * A ListBuffer without a feature has no memory or time cost for it.
+         */
+        enum ListBuffer_Feature : uint8_t
+        {
+            LISTBUFFER_PLAIN = 0,
+            /// Running sum and deviation, updated on every place and remove. Min and max in monotonic queues. Only for arithmetic types.
+            LISTBUFFER_STATISTICS = 1,
+            /// Median kept in SlidingMedian_Heaps, updated in O(log SIZE) on every place and remove.
+            LISTBUFFER_MEDIAN = 2
+        };
+
+        /**
+         * @brief Array positions of a ListBuffer whose element is smaller (larger if MAX) than every newer element, oldest first.
+         * The oldest entry is the position of the min (max). Adding at either end and removing the oldest element are amortised O(1).
+         */
+        template <typename T, size_t SIZE, bool MAX>
+        class ListBuffer_Extreme
+        {
+        public:
+            typedef typename std::conditional<(SIZE <= 0x100), uint8_t, typename std::conditional<(SIZE <= 0x10000), uint16_t, size_t>::type>::type Position;
+
+            /**
+             * @brief Adds the newest element. Drops entries that are no longer more extreme than it.
+             */
+            void placeNewest(const T *values, size_t position)
+            {
+                while (count_ > 0 && !isBeyond(values[positions_[wrap(first_ + count_ - 1)]], values[position]))
+                    count_--;
+                positions_[wrap(first_ + count_)] = Position(position);
+                count_++;
+            }
+
+            /**
+             * @brief Adds the oldest element. Only kept if it is more extreme than all others.
+             */
+            void placeOldest(const T *values, size_t position)
+            {
+                if (count_ > 0 && !isBeyond(values[position], values[positions_[first_]]))
+                    return;
+                first_ = wrap(first_ + SIZE - 1);
+                positions_[first_] = Position(position);
+                count_++;
+            }
+
+            /**
+             * @brief Must be called before the oldest element at position is removed.
+             */
+            void removeOldest(size_t position)
+            {
+                if (count_ == 0 || positions_[first_] != position)
+                    return;
+                first_ = wrap(first_ + 1);
+                count_--;
+            }
+
+            void clear()
+            {
+                first_ = 0;
+                count_ = 0;
+            }
+
+            /**
+             * @brief Position of the min (max). Only valid if at least one element was placed.
+             */
+            size_t getPosition() const { return positions_[first_]; }
+
+        private:
+            Position positions_[SIZE];
+            size_t first_ = 0;
+            size_t count_ = 0;
+
+            static bool isBeyond(const T &a, const T &b) { return MAX ? b < a : a < b; }
+
+            static size_t wrap(size_t index) { return index >= SIZE ? index - SIZE : index; }
+        };
+
+        /**
+         * @brief Running statistics of a ListBuffer. Empty unless ENABLE.
+         * Hooks take the element array and the array position, and whether the element is the oldest instead of the newest.
+         */
+        template <typename T, size_t SIZE, bool ENABLE>
+        class ListBuffer_Statistics
+        {
+        protected:
+            RunningStatistics *runningStatistics() const { return nullptr; }
+
+            void statisticsAdd(const T *, size_t, bool) {}
+
+            void statisticsRemove(const T *, size_t, bool) {}
+
+            void statisticsClear() {}
+
+            void statisticsReorder() {}
+
+            void extremes(const T *, size_t, size_t, size_t &, size_t &) const {}
+        };
+
+        template <typename T, size_t SIZE>
+        class ListBuffer_Statistics<T, SIZE, true>
+        {
+            static_assert(std::is_arithmetic<T>::value, "Running statistics are only available for arithmetic types.");
+
+        private:
+            // Mutable as min and max are handed to the statistics and rebuilt on demand.
+            mutable RunningStatistics statistics_;
+            mutable ListBuffer_Extreme<T, SIZE, false> min_;
+            mutable ListBuffer_Extreme<T, SIZE, true> max_;
+            mutable bool extremesValid_ = true;
+
+        protected:
+            RunningStatistics *runningStatistics() const { return &statistics_; }
+
+            void statisticsAdd(const T *values, size_t position, bool oldest)
+            {
+                statistics_.add(values[position]);
+                if (!extremesValid_)
+                    return;
+                if (oldest)
+                {
+                    min_.placeOldest(values, position);
+                    max_.placeOldest(values, position);
+                }
+                else
+                {
+                    min_.placeNewest(values, position);
+                    max_.placeNewest(values, position);
+                }
+            }
+
+            /**
+             * @brief Removing anything but the oldest element leaves min and max to be rebuilt by the next extremes() call.
+             */
+            void statisticsRemove(const T *values, size_t position, bool oldest)
+            {
+                statistics_.remove(values[position]);
+                if (!oldest)
+                {
+                    extremesValid_ = false;
+                    return;
+                }
+                min_.removeOldest(position);
+                max_.removeOldest(position);
+            }
+
+            void statisticsClear()
+            {
+                statistics_.reset();
+                min_.clear();
+                max_.clear();
+                extremesValid_ = true;
+            }
+
+            /**
+             * @brief Elements changed array positions. Min and max are rebuilt by the next extremes() call.
+             */
+            void statisticsReorder() { extremesValid_ = false; }
+
+            /**
+             * @brief Array positions of min and max of num elements, oldest at position back. O(1) unless a rebuild is due, then O(num).
+             */
+            void extremes(const T *values, size_t back, size_t num, size_t &min, size_t &max) const
+            {
+                if (!extremesValid_)
+                {
+                    min_.clear();
+                    max_.clear();
+                    for (size_t i = 0; i < num; i++)
+                    {
+                        size_t position = back + i >= SIZE ? back + i - SIZE : back + i;
+                        min_.placeNewest(values, position);
+                        max_.placeNewest(values, position);
+                    }
+                    extremesValid_ = true;
+                }
+                min = min_.getPosition();
+                max = max_.getPosition();
+            }
+        };
+
+        /**
+         * @brief Median heaps of a ListBuffer over its array positions. Empty unless ENABLE.
+         */
+        template <typename T, size_t SIZE, bool ENABLE>
+        class ListBuffer_Median
+        {
+        protected:
+            T median(const T *) const { return T(); }
+
+            void medianAdd(const T *, size_t) {}
+
+            void medianRemove(const T *, size_t) {}
+
+            void medianClear() {}
+        };
+
+        template <typename T, size_t SIZE>
+        class ListBuffer_Median<T, SIZE, true>
+        {
+        private:
+            SlidingMedian_Heaps<T, SIZE> heaps_;
+
+        protected:
+            T median(const T *values) const { return heaps_.getMedian(values); }
+
+            void medianAdd(const T *values, size_t position) { heaps_.insert(values, position); }
+
+            void medianRemove(const T *values, size_t position) { heaps_.remove(values, position); }
+
+            void medianClear() { heaps_.clear(); }
+        };
+
         /**
          * ListBuffer class that can be used as queue or stack.
          * Can also be used to sort values and calculate median, average, deviation.
+         * If SIZE is a power of two, indices are wrapped with a bit mask instead of a division or branch. Prefer such sizes for high rate buffers.
+         * @tparam FEATURES ListBuffer_Feature flags. With LISTBUFFER_STATISTICS, sum, average and deviation are O(1).
+         * Min and max are amortised O(1) while elements are only removed oldest first, as in a queue or sliding window.
+         * Removing the newest or an inner element, or sorting, makes the next getMin() or getMax() rebuild them in O(n).
+         * With LISTBUFFER_MEDIAN, getMedian() is O(1).
          */
-        template <typename T, size_t SIZE>
-        class ListBuffer : public List<T>
+        template <typename T, size_t SIZE, uint8_t FEATURES = LISTBUFFER_PLAIN>
+        class ListBuffer : public List<T>,
+                           private ListBuffer_Statistics<T, SIZE, (FEATURES & LISTBUFFER_STATISTICS) != 0>,
+                           private ListBuffer_Median<T, SIZE, (FEATURES & LISTBUFFER_MEDIAN) != 0>
         {
+        public:
+            /// @brief True if SIZE is a power of two and indices are wrapped with MASK.
+            static constexpr bool POWER_OF_TWO = SIZE != 0 && (SIZE & (SIZE - 1)) == 0;
+
+            /// @brief True if running statistics are kept.
+            static constexpr bool STATISTICS = (FEATURES & LISTBUFFER_STATISTICS) != 0;
+
+            /// @brief True if the median is kept.
+            static constexpr bool MEDIAN = (FEATURES & LISTBUFFER_MEDIAN) != 0;
+
+            /// @brief Largest buffer in bytes that getMedian() and getPercentile() without scratch memory copy onto the stack. Larger ones copy to the heap.
+            static constexpr size_t STACK_SELECT_BYTES = 1024;
+
         private:
+            static constexpr size_t MASK = SIZE - 1;
+
+            static constexpr bool TRACKED = FEATURES != LISTBUFFER_PLAIN;
+
+            typedef ListBuffer_Statistics<T, SIZE, STATISTICS> Statistics;
+            typedef ListBuffer_Median<T, SIZE, MEDIAN> Median;
+
+            using Statistics::runningStatistics;
+            using Statistics::statisticsAdd;
+            using Statistics::statisticsRemove;
+            using Statistics::statisticsClear;
+            using Statistics::statisticsReorder;
+            using Statistics::extremes;
+            using Median::median;
+            using Median::medianAdd;
+            using Median::medianRemove;
+            using Median::medianClear;
+
             // Array for element storage
             T listBufferArray_[SIZE];
 
@@ -57,6 +424,29 @@ namespace VCTR
              */
             size_t sizeMax() const;
 
+            /**
+             * @brief Gives the elements as the up to two contiguous blocks they are stored in. Oldest element first, so the reverse of index order.
+             * Use this for loops that do not depend on order (sums, min/max, copying out), they then run over plain arrays.
+             * @returns view of the elements. Invalidated by placing or removing elements.
+             */
+            ListSpanPair<T> getSegments();
+
+            /**
+             * @brief Read only version of getSegments().
+             */
+            ListSpanPair<const T> getSegments() const;
+
+            /**
+             * @brief Iterators in index order, newest element first.
+             */
+            ListBuffer_Iterator<T> begin() { return ListBuffer_Iterator<T>(listBufferArray_, SIZE, wrap(front_ + SIZE - 1), numElements_); }
+
+            ListBuffer_Iterator<T> end() { return ListBuffer_Iterator<T>(listBufferArray_, SIZE, 0, 0); }
+
+            ListBuffer_Iterator<const T> begin() const { return ListBuffer_Iterator<const T>(listBufferArray_, SIZE, wrap(front_ + SIZE - 1), numElements_); }
+
+            ListBuffer_Iterator<const T> end() const { return ListBuffer_Iterator<const T>(listBufferArray_, SIZE, 0, 0); }
+
             /**
              * Places a new element to the front of the ListBuffer. AKA stack push.
              *
@@ -66,6 +456,52 @@ namespace VCTR
              */
             bool placeFront(const T &element, bool overwrite = false);
 
+            /**
+             * Moves a new element to the front of the ListBuffer. AKA stack push.
+             *
+             * @param element element to be moved into ListBuffer.
+             * @param overwrite Overwrites elements at back if true. Default false.
+             * @return true if placed into ListBuffer.
+             */
+            bool placeFront(T &&element, bool overwrite = false);
+
+            /**
+             * Makes space for a new element at the front of the ListBuffer and returns it, so it can be written in place.
+             *
+             * @param overwrite Overwrites elements at back if true. Default false.
+             * @return pointer to the new front element. nullptr if ListBuffer is full.
+             */
+            T *placeFrontSlot(bool overwrite = false);
+
+            /**
+             * Places multiple elements to the front of the ListBuffer in one go. The last given element will be the new front.
+             * Same as calling placeFront() for each element, but copies in at most two blocks.
+             *
+             * @param elements Pointer to elements to be placed. Oldest first.
+             * @param numElements Number of elements to place.
+             * @param overwrite Overwrites elements at back if true. Default false.
+             * @return number of elements placed. If not overwriting, placing stops once full. If overwriting, only the last sizeMax() elements are kept.
+             */
+            size_t placeFrontN(const T *elements, size_t numElements, bool overwrite = false);
+
+            /**
+             * Takes multiple elements from the back of the ListBuffer in one go. Same as calling takeBack() repeatedly, but moves out in at most two blocks.
+             *
+             * @param elements Pointer to array receiving the elements. Oldest first.
+             * @param maxElements Maximum number of elements to take. Size of elements array.
+             * @return number of elements taken.
+             */
+            size_t takeBackN(T *elements, size_t maxElements);
+
+            /**
+             * Copies multiple elements from the back of the ListBuffer without removing them. Copies in at most two blocks.
+             *
+             * @param elements Pointer to array receiving the elements. Oldest first.
+             * @param maxElements Maximum number of elements to copy. Size of elements array.
+             * @return number of elements copied.
+             */
+            size_t copyOut(T *elements, size_t maxElements) const;
+
             /**
              * Places a new element to the back of the ListBuffer. AKA enqueue item.
              *
@@ -75,6 +511,15 @@ namespace VCTR
              */
             bool placeBack(const T &element, bool overwrite = false);
 
+            /**
+             * Moves a new element to the back of the ListBuffer. AKA enqueue item.
+             *
+             * @param element element to be moved into ListBuffer.
+             * @param overwrite Overwrites elements at front if true. Default false.
+             * @return true if placed into ListBuffer.
+             */
+            bool placeBack(T &&element, bool overwrite = false);
+
             /**
              * Takes a element from the front of the ListBuffer and places it into element. AKA dequeue item.
              * peekFront() wont remove element.
@@ -150,239 +595,643 @@ namespace VCTR
              */
             // bool insertElementIndex(const T &element, size_t index);
 
+            /**
+             * @brief Recalculates the running statistics and median from all elements. Does nothing for a plain ListBuffer.
+             * @note Writing elements through placeFrontSlot() or operator[] is not tracked. Call this afterwards.
+             */
+            void recalculateStatistics();
+
+            /**
+             * @returns the running statistics. Requires LISTBUFFER_STATISTICS.
+             */
+            const RunningStatistics &getStatistics() const;
+
             /**
              * @returns the sum of all elements.
              */
             T getSum() const;
 
+            /**
+             * @returns the smallest element. T() if empty.
+             */
+            T getMin() const;
+
+            /**
+             * @returns the largest element. T() if empty.
+             */
+            T getMax() const;
+
             /**
              * @returns the average of all elements.
              */
             T getAverage() const;
 
             /**
-             * Sorts the elements. This will change the array!
+             * Sorts the elements so index 0 is the smallest. This will change the array!
+             * Uses introsort, O(n log n) even for already sorted data, without recursion or extra memory.
              */
             void sortElements();
 
-            /**
-             * Sorts elements and returns median.
-             * @return median.
-             */
-            T getMedian() const;
+            /**
+             * Same as sortElements(), but integer and float elements are radix sorted in O(n) once there are 512 or more. Other types are sorted as by sortElements().
+             * @param scratch Memory for at least size() elements. Contents are overwritten.
+             */
+            void sortElements(T *scratch);
+
+            /**
+             * Selects the median in O(n) from a copy, without changing the ListBuffer. Average of the two middle elements if size is even.
+             * O(1) with LISTBUFFER_MEDIAN. Buffers up to STACK_SELECT_BYTES are copied onto the stack, larger ones to the heap allocator.
+             * Prefer getMedian(T *scratch) for those.
+             * @return median. T() if the heap is out of memory.
+             */
+            T getMedian() const;
+
+            /**
+             * Same as getMedian(), but copies into the given memory instead of the stack.
+             * @param scratch Memory for at least size() elements. Contents are overwritten. Unused with LISTBUFFER_MEDIAN.
+             * @return median.
+             */
+            T getMedian(T *scratch) const;
+
+            /**
+             * Selects the element at the given percentile in O(n) from a copy, without changing the ListBuffer.
+             * Copied like getMedian(), prefer getPercentile(float, T *scratch) for buffers larger than STACK_SELECT_BYTES.
+             * @param percentile 0 to 100. 0 gives the smallest, 100 the largest element. Rounded to the nearest element.
+             * @return element at percentile. T() if empty or the heap is out of memory.
+             */
+            T getPercentile(float percentile) const;
+
+            /**
+             * Same as getPercentile(float), but copies into the given memory instead of the stack.
+             * @param percentile 0 to 100.
+             * @param scratch Memory for at least size() elements. Contents are overwritten.
+             * @return element at percentile. T() if empty.
+             */
+            T getPercentile(float percentile, T *scratch) const;
+
+            /**
+             * @returns the standard deviation.
+             */
+            T getStandardDeviation() const;
+
+            /**
+             * @returns the standard error.
+             */
+            T getStandardError() const;
+
+            /**
+             * Used to access ListBuffer like an array.
+             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
+             * @returns copy of element from index.
+             */
+            T &operator[](size_t index) override;
+
+            /**
+             * Used to access ListBuffer like an array.
+             * Const version. Returns a const reference to element.
+             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
+             * @returns copy of element from index.
+             */
+            const T &operator[](size_t index) const override;
+
+            /**
+             * Safer way to access ListBuffer like an array.
+             * Indexes outside of ListBuffer will wrap around ListBuffer.
+             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
+             * @returns copy of element from index.
+             */
+            T &operator()(int32_t index) override;
+
+            /**
+             * Safer way to access ListBuffer like an array.
+             * Const version. Returns a const reference to element.
+             * Indexes outside of ListBuffer will wrap around ListBuffer.
+             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
+             * @returns copy of element from index.
+             */
+            const T &operator()(int32_t index) const override;
+
+            /**
+             * Needs to be overloaded to also copy the data to instance.
+             * Not doing this will cause 2 ListBuffers to share the exact same elements.
+             */
+            ListBuffer operator=(const ListBuffer &toBeCopied);
+
+            /**
+             * Removes all items from ListBuffer. Not computationaly intensive.
+             */
+            void clear();
+
+        private:
+            /**
+             * @brief Moves the elements to the start of the array, so they are contiguous. Oldest element first.
+             * @returns the elements.
+             */
+            ListSpan<T> linearize();
+
+            void sortSpan(ListSpan<T> elements, T *scratch, std::true_type);
+
+            void sortSpan(ListSpan<T> elements, T *scratch, std::false_type);
+
+            /**
+             * @brief Wraps an array index below 2*SIZE into the array.
+             */
+            static size_t wrap(size_t index)
+            {
+                if (POWER_OF_TWO)
+                    return index & MASK;
+                return index >= SIZE ? index - SIZE : index;
+            }
+
+            /**
+             * @brief Copies or moves num elements between arrays. Uses memcpy for trivially copyable types.
+             */
+            static void copyBlock(T *destination, const T *source, size_t num);
+
+            static void moveBlock(T *destination, T *source, size_t num);
+
+            /**
+             * @brief Adds or removes the element at the given array position to or from the enabled features.
+             * @param oldest True if the element is the oldest, false if it is the newest.
+             */
+            void trackAdd(size_t position, bool oldest)
+            {
+                statisticsAdd(listBufferArray_, position, oldest);
+                medianAdd(listBufferArray_, position);
+            }
+
+            void trackRemove(size_t position, bool oldest)
+            {
+                statisticsRemove(listBufferArray_, position, oldest);
+                medianRemove(listBufferArray_, position);
+            }
+
+            /**
+             * @brief Removes the num newest or oldest elements from the enabled features, before they are removed.
+             */
+            void untrackFront(size_t num);
+
+            void untrackBack(size_t num);
+
+            void trackClear();
+
+            /**
+             * @brief Rebuilds the median heaps and marks min and max for a rebuild after elements changed array positions.
+             */
+            void trackReorder();
+
+            T medianOf(std::true_type) const;
+
+            T medianOf(std::false_type) const;
+
+            /**
+             * @brief Selects from a copy on the stack if true_type, otherwise on the heap.
+             */
+            T medianOnCopy(std::true_type) const;
+
+            T medianOnCopy(std::false_type) const;
+
+            T percentileOnCopy(float percentile, std::true_type) const;
+
+            T percentileOnCopy(float percentile, std::false_type) const;
+
+            /**
+             * @brief Average without running statistics.
+             */
+            T averageOf(std::true_type) const;
+
+            T averageOf(std::false_type) const;
+
+            static T fromStatistics(double value, std::true_type) { return T(value); }
+
+            static T fromStatistics(double, std::false_type) { return T(); }
+
+        };
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        constexpr bool ListBuffer<T, SIZE, FEATURES>::POWER_OF_TWO;
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        constexpr bool ListBuffer<T, SIZE, FEATURES>::STATISTICS;
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        constexpr bool ListBuffer<T, SIZE, FEATURES>::MEDIAN;
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        constexpr size_t ListBuffer<T, SIZE, FEATURES>::STACK_SELECT_BYTES;
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::copyBlock(T *destination, const T *source, size_t num)
+        {
+            if (std::is_trivially_copyable<T>::value)
+            {
+                if (num > 0)
+                    memcpy(static_cast<void *>(destination), static_cast<const void *>(source), num * sizeof(T));
+                return;
+            }
+
+            for (size_t i = 0; i < num; i++)
+                destination[i] = source[i];
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::moveBlock(T *destination, T *source, size_t num)
+        {
+            if (std::is_trivially_copyable<T>::value)
+            {
+                copyBlock(destination, source, num);
+                return;
+            }
+
+            for (size_t i = 0; i < num; i++)
+                destination[i] = std::move(source[i]);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::recalculateStatistics()
+        {
+            if (!TRACKED)
+                return;
+
+            trackClear();
+
+            for (size_t i = 0; i < numElements_; i++)
+                trackAdd(wrap(back_ + i), false);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::untrackFront(size_t num)
+        {
+            if (!TRACKED)
+                return;
+
+            if (num == numElements_)
+            {
+                trackClear();
+                return;
+            }
+
+            for (size_t i = 1; i <= num; i++)
+                trackRemove(wrap(front_ + SIZE - i), false);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::untrackBack(size_t num)
+        {
+            if (!TRACKED)
+                return;
+
+            if (num == numElements_)
+            {
+                trackClear();
+                return;
+            }
+
+            for (size_t i = 0; i < num; i++)
+                trackRemove(wrap(back_ + i), true);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::trackClear()
+        {
+            statisticsClear();
+            medianClear();
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::trackReorder()
+        {
+            statisticsReorder();
+
+            if (!MEDIAN)
+                return;
+
+            medianClear();
+
+            for (size_t i = 0; i < numElements_; i++)
+                medianAdd(listBufferArray_, wrap(back_ + i));
+        }
 
-            /**
-             * @returns the standard deviation.
-             */
-            T getStandardDeviation() const;
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        const RunningStatistics &ListBuffer<T, SIZE, FEATURES>::getStatistics() const
+        {
+            static_assert(STATISTICS, "getStatistics() requires LISTBUFFER_STATISTICS.");
 
-            /**
-             * @returns the standard error.
-             */
-            T getStandardError() const;
+            RunningStatistics *statistics = runningStatistics();
+            if (numElements_ > 0)
+            {
+                size_t min, max;
+                extremes(listBufferArray_, back_, numElements_, min, max);
+                statistics->setExtremes(listBufferArray_[min], listBufferArray_[max]);
+            }
+            return *statistics;
+        }
 
-            /**
-             * Used to access ListBuffer like an array.
-             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
-             * @returns copy of element from index.
-             */
-            T &operator[](size_t index) override;
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getMin() const
+        {
+            if (numElements_ == 0)
+                return T();
 
-            /**
-             * Used to access ListBuffer like an array.
-             * Const version. Returns a const reference to element.
-             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
-             * @returns copy of element from index.
-             */
-            const T &operator[](size_t index) const override;
+            if (STATISTICS)
+            {
+                size_t min, max;
+                extremes(listBufferArray_, back_, numElements_, min, max);
+                return listBufferArray_[min];
+            }
 
-            /**
-             * Safer way to access ListBuffer like an array.
-             * Indexes outside of ListBuffer will wrap around ListBuffer.
-             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
-             * @returns copy of element from index.
-             */
-            T &operator()(int32_t index) override;
+            ListSpanPair<const T> segments = getSegments();
+            T min = segments[0];
+            T max = min;
+            reduceMinMax(segments.first.data(), segments.first.size(), min, max);
+            reduceMinMax(segments.second.data(), segments.second.size(), min, max);
 
-            /**
-             * Safer way to access ListBuffer like an array.
-             * Const version. Returns a const reference to element.
-             * Indexes outside of ListBuffer will wrap around ListBuffer.
-             * Starts from front of ListBuffer("oldest" element or first that was placed inside).
-             * @returns copy of element from index.
-             */
-            const T &operator()(int32_t index) const override;
+            return min;
+        }
 
-            /**
-             * Needs to be overloaded to also copy the data to instance.
-             * Not doing this will cause 2 ListBuffers to share the exact same elements.
-             */
-            ListBuffer operator=(const ListBuffer &toBeCopied);
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getMax() const
+        {
+            if (numElements_ == 0)
+                return T();
 
-            /**
-             * Removes all items from ListBuffer. Not computationaly intensive.
-             */
-            void clear();
+            if (STATISTICS)
+            {
+                size_t min, max;
+                extremes(listBufferArray_, back_, numElements_, min, max);
+                return listBufferArray_[max];
+            }
 
-        private:
-            void quickSort(size_t left, size_t right);
+            ListSpanPair<const T> segments = getSegments();
+            T min = segments[0];
+            T max = min;
+            reduceMinMax(segments.first.data(), segments.first.size(), min, max);
+            reduceMinMax(segments.second.data(), segments.second.size(), min, max);
 
-            size_t quickSortPartition(size_t left, size_t right);
-        };
+            return max;
+        }
 
-        template <typename T, size_t SIZE>
-        T ListBuffer<T, SIZE>::getStandardError() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getStandardError() const
         {
             if (numElements_ < 2)
                 return T();
             return getStandardDeviation() / sqrt(numElements_);
         }
 
-        template <typename T, size_t SIZE>
-        T ListBuffer<T, SIZE>::getStandardDeviation() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getStandardDeviation() const
         {
 
             if (numElements_ < 2)
                 return T();
 
-            T standardDev = 0;
+            if (STATISTICS)
+                return fromStatistics(runningStatistics()->getStandardDeviation(), std::is_arithmetic<T>());
 
             T avg = getAverage();
 
-            for (size_t i = 0; i < numElements_; i++)
-            {
-
-                T diff = (*this)[i] - avg;
+            ListSpanPair<const T> segments = getSegments();
 
-                standardDev = standardDev + diff * diff;
-            }
+            T standardDev = reduceSquaredDeviation(segments.first.data(), segments.first.size(), avg) +
+                            reduceSquaredDeviation(segments.second.data(), segments.second.size(), avg);
 
             standardDev = sqrt(standardDev / (numElements_ - 1));
 
             return standardDev;
         }
 
-        template <typename T, size_t SIZE>
-        T ListBuffer<T, SIZE>::getMedian() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getMedian() const
+        {
+            return medianOf(std::integral_constant<bool, MEDIAN>());
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::medianOf(std::true_type) const
+        {
+            return median(listBufferArray_);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::medianOf(std::false_type) const
+        {
+            return medianOnCopy(std::integral_constant<bool, SIZE * sizeof(T) <= STACK_SELECT_BYTES>());
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::medianOnCopy(std::true_type) const
+        {
+            T elements[SIZE];
+            return getMedian(elements);
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::medianOnCopy(std::false_type) const
+        {
+            ListBuffer_Scratch<T> elements(numElements_);
+            if (elements.data() == nullptr)
+                return T();
+            return getMedian(elements.data());
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getMedian(T *scratch) const
         {
 
+            if (MEDIAN)
+                return median(listBufferArray_);
+
             if (numElements_ == 0)
                 return T();
 
-            T median;
+            copyOut(scratch, numElements_);
 
-            ListBuffer<T, SIZE> ListBufferSorted;
+            size_t middle = numElements_ / 2;
+            selectNth(scratch, numElements_, middle);
 
-            ListBufferSorted = *this;
+            if (numElements_ % 2 != 0)
+                return scratch[middle];
 
-            ListBufferSorted.sortElements();
+            // Lower middle element is the largest of the ones before middle.
+            const T *lower = &scratch[0];
+            for (size_t i = 1; i < middle; i++)
+                if (*lower < scratch[i])
+                    lower = &scratch[i];
 
-            if (numElements_ % 2 == 0)
-            {
+            return (*lower + scratch[middle]) / 2;
+        }
 
-                median = (ListBufferSorted[numElements_ / 2 - 1] + ListBufferSorted[numElements_ / 2]) / 2;
-            }
-            else
-            {
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getPercentile(float percentile) const
+        {
+            return percentileOnCopy(percentile, std::integral_constant<bool, SIZE * sizeof(T) <= STACK_SELECT_BYTES>());
+        }
 
-                median = ListBufferSorted[numElements_ / 2];
-            }
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::percentileOnCopy(float percentile, std::true_type) const
+        {
+            T elements[SIZE];
+            return getPercentile(percentile, elements);
+        }
 
-            return median;
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::percentileOnCopy(float percentile, std::false_type) const
+        {
+            ListBuffer_Scratch<T> elements(numElements_);
+            if (elements.data() == nullptr)
+                return T();
+            return getPercentile(percentile, elements.data());
         }
 
-        template <typename T, size_t SIZE>
-        T ListBuffer<T, SIZE>::getAverage() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getPercentile(float percentile, T *scratch) const
         {
+
             if (numElements_ == 0)
                 return T();
-            return getSum() / numElements_;
+
+            if (percentile < 0)
+                percentile = 0;
+            if (percentile > 100)
+                percentile = 100;
+
+            size_t n = size_t(percentile / 100 * (numElements_ - 1) + 0.5f);
+
+            copyOut(scratch, numElements_);
+            selectNth(scratch, numElements_, n);
+
+            return scratch[n];
         }
 
-        template <typename T, size_t SIZE>
-        T ListBuffer<T, SIZE>::getSum() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getAverage() const
         {
+            if (numElements_ == 0)
+                return T();
 
-            T sum_ = 0;
+            if (STATISTICS)
+                return fromStatistics(runningStatistics()->getMean(), std::is_arithmetic<T>());
 
-            for (size_t i = 0; i < numElements_; i++)
-            {
-                sum_ = sum_ + (*this)[i];
-            }
+            return averageOf(std::is_arithmetic<T>());
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::averageOf(std::true_type) const
+        {
+            // Integers are summed and divided in at least 64 bits. In T, narrow types would overflow and the count could truncate to 0,
+            // and signed sums divided by size_t would be converted to unsigned.
+            typedef typename std::common_type<T, int64_t>::type Wide;
+
+            Wide sum = 0;
+            if (std::is_floating_point<T>::value)
+                sum = getSum();
+            else
+                for (const T &element : getSegments())
+                    sum += element;
 
-            return sum_;
+            return T(sum / Wide(numElements_));
         }
 
-        template <typename T, size_t SIZE>
-        size_t ListBuffer<T, SIZE>::quickSortPartition(size_t left, size_t right)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::averageOf(std::false_type) const
         {
+            return getSum() / numElements_;
+        }
 
-            T pivot = (*this)[right];
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T ListBuffer<T, SIZE, FEATURES>::getSum() const
+        {
 
-            size_t i = left;
+            if (STATISTICS)
+                return fromStatistics(runningStatistics()->getSum(), std::is_arithmetic<T>());
 
-            for (size_t j = left; j < right; j++)
-            {
+            ListSpanPair<const T> segments = getSegments();
 
-                if ((*this)[j] < pivot)
-                {
+            return reduceSum(segments.first.data(), segments.first.size()) + reduceSum(segments.second.data(), segments.second.size());
+        }
 
-                    // swap
-                    T temp = (*this)[i];
-                    (*this)[i] = (*this)[j];
-                    (*this)[j] = temp;
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        ListSpan<T> ListBuffer<T, SIZE, FEATURES>::linearize()
+        {
 
-                    i++;
-                }
-            }
+            ListSpanPair<T> segments = getSegments();
+            if (segments.second.isEmpty())
+                return segments.first;
+
+            // Rotate the whole array left so the oldest element is at 0.
+            size_t start = segments.first.data() - listBufferArray_;
+            reverseElements(listBufferArray_, start);
+            reverseElements(listBufferArray_ + start, SIZE - start);
+            reverseElements(listBufferArray_, SIZE);
 
-            // swap
-            T temp = (*this)[i];
-            (*this)[i] = (*this)[right];
-            (*this)[right] = temp;
+            back_ = 0;
+            front_ = wrap(numElements_);
 
-            return i;
+            return ListSpan<T>(listBufferArray_, numElements_);
         }
 
-        template <typename T, size_t SIZE>
-        void ListBuffer<T, SIZE>::quickSort(size_t left, size_t right)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::sortSpan(ListSpan<T> elements, T *scratch, std::true_type)
         {
+            // Below this, clearing and summing the byte counts costs more than introsort.
+            if (elements.size() < 512)
+                sortIntro(elements.data(), elements.size());
+            else
+                sortRadix(elements.data(), scratch, elements.size());
+        }
 
-            if (left < right)
-            {
-
-                size_t p = quickSortPartition(left, right);
-                if (p != left)
-                    quickSort(left, p - 1);
-                quickSort(p + 1, right);
-            }
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::sortSpan(ListSpan<T> elements, T *, std::false_type)
+        {
+            sortIntro(elements.data(), elements.size());
         }
 
-        template <typename T, size_t SIZE>
-        void ListBuffer<T, SIZE>::sortElements()
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::sortElements()
         {
 
             // Check if nothing to sort
             if (numElements_ < 2)
                 return;
 
-            quickSort(0, numElements_ - 1);
+            // Index order is newest first, the reverse of array order.
+            ListSpan<T> elements = linearize();
+            sortIntro(elements.data(), elements.size());
+            reverseElements(elements.data(), elements.size());
+
+            trackReorder();
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::sortElements(T *scratch)
+        {
+
+            if (numElements_ < 2)
+                return;
+
+            ListSpan<T> elements = linearize();
+            sortSpan(elements, scratch, std::integral_constant<bool, std::is_arithmetic<T>::value && sizeof(T) <= 8>());
+            reverseElements(elements.data(), elements.size());
+
+            trackReorder();
         }
 
-        template <typename T, size_t SIZE>
-        void ListBuffer<T, SIZE>::clear()
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::clear()
         {
             front_ = 0;
             back_ = 0;
             numElements_ = 0;
+            trackClear();
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::removeElementIndex(int32_t index)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::removeElementIndex(int32_t index)
         {
 
-            // Make sure ListBuffer isnt empty
-            if (numElements_ == 0)
+            // Make sure index is inside ListBuffer
+            if (index < 0 || size_t(index) >= numElements_)
                 return false;
 
             // Special case if numberElements if 1. Algorithm below cant handle this case.
@@ -392,6 +1241,8 @@ namespace VCTR
                 return true;
             }
 
+            statisticsRemove(listBufferArray_, wrap(back_ + numElements_ - 1 - index), false);
+
             // We have to move all elements ahead the one to be removed, one place down.
             for (size_t j = index; j < numElements_ - 1; j++)
             {
@@ -399,14 +1250,18 @@ namespace VCTR
                 ((*this)[j]) = ((*this)[j + 1]);
             }
 
+            // The oldest slot is now unused.
+            back_ = wrap(back_ + 1);
             numElements_--;
 
-            // If we exited the loop then item was not found.
+            // Shifted elements changed array positions.
+            trackReorder();
+
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::removeElement(T *pointerToElement)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::removeElement(T *pointerToElement)
         {
 
             // Make sure ListBuffer isnt empty
@@ -429,66 +1284,64 @@ namespace VCTR
             return false;
         }
 
-        template <typename T, size_t SIZE>
-        T &ListBuffer<T, SIZE>::operator[](size_t index)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T &ListBuffer<T, SIZE, FEATURES>::operator[](size_t index)
         {
-            if (index >= front_)
-                return listBufferArray_[SIZE + front_ - index - 1];
-            else
-                return listBufferArray_[front_ - index - 1];
+            return listBufferArray_[wrap(front_ + SIZE - 1 - index)];
         }
 
-        template <typename T, size_t SIZE>
-        const T &ListBuffer<T, SIZE>::operator[](size_t index) const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        const T &ListBuffer<T, SIZE, FEATURES>::operator[](size_t index) const
         {
-            if (index >= front_)
-                return listBufferArray_[SIZE + front_ - index - 1];
-            else
-                return listBufferArray_[front_ - index - 1];
+            return listBufferArray_[wrap(front_ + SIZE - 1 - index)];
         }
 
-        template <typename T, size_t SIZE>
-        T &ListBuffer<T, SIZE>::operator()(int32_t index)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T &ListBuffer<T, SIZE, FEATURES>::operator()(int32_t index)
         {
+            // Wrap index into the elements first, then into the array.
+            int32_t num = numElements_;
+            index %= num;
             if (index < 0)
-                index = numElements_ + index;
-            return listBufferArray_[(front_ - index - 1) % numElements_];
+                index += num;
+            return listBufferArray_[wrap(front_ + SIZE - 1 - index)];
         }
 
-        template <typename T, size_t SIZE>
-        const T &ListBuffer<T, SIZE>::operator()(int32_t index) const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        const T &ListBuffer<T, SIZE, FEATURES>::operator()(int32_t index) const
         {
+            // Wrap index into the elements first, then into the array.
+            int32_t num = numElements_;
+            index %= num;
             if (index < 0)
-                index = numElements_ + index;
-            return listBufferArray_[(front_ - index - 1) % numElements_];
+                index += num;
+            return listBufferArray_[wrap(front_ + SIZE - 1 - index)];
         }
 
-        template <typename T, size_t SIZE>
-        ListBuffer<T, SIZE> ListBuffer<T, SIZE>::operator=(const ListBuffer &toBeCopied)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        ListBuffer<T, SIZE, FEATURES> ListBuffer<T, SIZE, FEATURES>::operator=(const ListBuffer &toBeCopied)
         {
 
-            size_t sizeToBeCopied = toBeCopied.size();
-
-            for (size_t i = 0; i < sizeToBeCopied; i++)
-                this->placeBack(toBeCopied[i]);
+            for (const T &element : toBeCopied)
+                this->placeBack(element);
 
             return *this;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::peekFront(T &element)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::peekFront(T &element)
         {
 
             if (numElements_ == 0)
                 return false;
 
-            element = listBufferArray_[(front_ + 1) % SIZE];
+            element = listBufferArray_[wrap(front_ + SIZE - 1)];
 
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::peekBack(T &element)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::peekBack(T &element)
         {
 
             if (numElements_ == 0)
@@ -499,85 +1352,125 @@ namespace VCTR
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::takeFront(T &element)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::takeFront(T &element)
         {
 
             if (numElements_ == 0)
                 return false;
 
-            if (front_ == 0)
-                front_ = SIZE - 1;
-            else
-                front_--;
+            front_ = wrap(front_ + SIZE - 1);
 
             element = listBufferArray_[front_];
+            trackRemove(front_, false);
 
             numElements_--;
 
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::takeBack(T &element)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::takeBack(T &element)
         {
 
             if (numElements_ == 0)
                 return false;
 
             element = listBufferArray_[back_];
+            trackRemove(back_, true);
 
-            back_ = (back_ + 1) % SIZE;
+            back_ = wrap(back_ + 1);
 
             numElements_--;
 
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        size_t ListBuffer<T, SIZE>::size() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        size_t ListBuffer<T, SIZE, FEATURES>::size() const
         {
             return numElements_;
         }
 
-        template <typename T, size_t SIZE>
-        size_t ListBuffer<T, SIZE>::sizeMax() const
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        size_t ListBuffer<T, SIZE, FEATURES>::sizeMax() const
         {
             return SIZE;
         }
 
-        template <typename T, size_t SIZE>
-        void ListBuffer<T, SIZE>::removeFront(size_t num)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        ListSpanPair<T> ListBuffer<T, SIZE, FEATURES>::getSegments()
+        {
+            size_t start = wrap(front_ + SIZE - numElements_);
+            size_t firstSize = SIZE - start < numElements_ ? SIZE - start : numElements_;
+
+            return ListSpanPair<T>(ListSpan<T>(listBufferArray_ + start, firstSize), ListSpan<T>(listBufferArray_, numElements_ - firstSize));
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        ListSpanPair<const T> ListBuffer<T, SIZE, FEATURES>::getSegments() const
+        {
+            return const_cast<ListBuffer<T, SIZE, FEATURES> *>(this)->getSegments();
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::removeFront(size_t num)
         {
 
             if (numElements_ < num) // If we want to remove more than we have then remove all.
                 num = numElements_;
 
-            if (front_ < num)
-                front_ = SIZE + front_ - num;
-            else
-                front_ -= num;
+            untrackFront(num);
+
+            front_ = wrap(front_ + SIZE - num);
 
             numElements_ -= num;
         }
 
-        template <typename T, size_t SIZE>
-        void ListBuffer<T, SIZE>::removeBack(size_t num)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        void ListBuffer<T, SIZE, FEATURES>::removeBack(size_t num)
         {
 
             if (numElements_ < num)
                 num = numElements_;
 
-            if (back_ + num >= SIZE)
-                back_ = back_ + num - SIZE;
-            else
-                back_ += num;
+            untrackBack(num);
+
+            back_ = wrap(back_ + num);
 
             numElements_ -= num;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::placeFront(const T &element, bool overwrite)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::placeFront(const T &element, bool overwrite)
+        {
+
+            T *slot = placeFrontSlot(overwrite);
+            if (slot == nullptr)
+                return false;
+
+            *slot = element;
+            trackAdd(slot - listBufferArray_, false);
+
+            return true;
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::placeFront(T &&element, bool overwrite)
+        {
+
+            T *slot = placeFrontSlot(overwrite);
+            if (slot == nullptr)
+                return false;
+
+            *slot = std::move(element);
+            trackAdd(slot - listBufferArray_, false);
+
+            return true;
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        T *ListBuffer<T, SIZE, FEATURES>::placeFrontSlot(bool overwrite)
         {
 
             if (numElements_ == SIZE)
@@ -585,20 +1478,118 @@ namespace VCTR
 
                 if (overwrite)
                     removeBack();
+                else
+                    return nullptr;
+            }
+
+            T *slot = &listBufferArray_[front_];
+
+            front_ = wrap(front_ + 1);
+            numElements_++;
+
+            return slot;
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        size_t ListBuffer<T, SIZE, FEATURES>::placeFrontN(const T *elements, size_t numElements, bool overwrite)
+        {
+
+            size_t freeSpace = SIZE - numElements_;
+            if (numElements > freeSpace)
+            {
+
+                if (overwrite)
+                {
+                    // Elements that would be overwritten by the following ones are skipped.
+                    if (numElements > SIZE)
+                    {
+                        elements += numElements - SIZE;
+                        numElements = SIZE;
+                    }
+                    removeBack(numElements - freeSpace);
+                }
+                else
+                    numElements = freeSpace;
+            }
+
+            // Copy up to end of array, then the rest from array start.
+            size_t firstBlock = SIZE - front_;
+            if (firstBlock > numElements)
+                firstBlock = numElements;
+
+            copyBlock(listBufferArray_ + front_, elements, firstBlock);
+            copyBlock(listBufferArray_, elements + firstBlock, numElements - firstBlock);
+
+            if (TRACKED)
+                for (size_t i = 0; i < numElements; i++)
+                    trackAdd(wrap(front_ + i), false);
+
+            front_ = wrap(front_ + numElements);
+            numElements_ += numElements;
+
+            return numElements;
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        size_t ListBuffer<T, SIZE, FEATURES>::takeBackN(T *elements, size_t maxElements)
+        {
+
+            ListSpanPair<T> segments = getSegments();
+            ListSpan<T> first = segments.first.subspan(0, maxElements);
+            ListSpan<T> second = segments.second.subspan(0, maxElements - first.size());
+
+            size_t num = first.size() + second.size();
+            // Untracked while the elements are still in place.
+            untrackBack(num);
+
+            moveBlock(elements, first.data(), first.size());
+            moveBlock(elements + first.size(), second.data(), second.size());
+
+            back_ = wrap(back_ + num);
+            numElements_ -= num;
+
+            return num;
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        size_t ListBuffer<T, SIZE, FEATURES>::copyOut(T *elements, size_t maxElements) const
+        {
+
+            ListSpanPair<const T> segments = getSegments();
+            ListSpan<const T> first = segments.first.subspan(0, maxElements);
+            ListSpan<const T> second = segments.second.subspan(0, maxElements - first.size());
+
+            copyBlock(elements, first.data(), first.size());
+            copyBlock(elements + first.size(), second.data(), second.size());
+
+            return first.size() + second.size();
+        }
+
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::placeBack(const T &element, bool overwrite)
+        {
+
+            if (numElements_ == SIZE)
+            {
+
+                if (overwrite)
+                    removeFront();
                 else
                     return false;
             }
 
-            listBufferArray_[front_] = element;
+            back_ = wrap(back_ + SIZE - 1);
+
+            listBufferArray_[back_] = element;
+            trackAdd(back_, true);
 
-            front_ = (front_ + 1) % SIZE;
             numElements_++;
 
             return true;
         }
 
-        template <typename T, size_t SIZE>
-        bool ListBuffer<T, SIZE>::placeBack(const T &element, bool overwrite)
+        template <typename T, size_t SIZE, uint8_t FEATURES>
+        bool ListBuffer<T, SIZE, FEATURES>::placeBack(T &&element, bool overwrite)
         {
 
             if (numElements_ == SIZE)
@@ -610,12 +1601,10 @@ namespace VCTR
                     return false;
             }
 
-            if (back_ == 0)
-                back_ = SIZE - 1;
-            else
-                back_--;
+            back_ = wrap(back_ + SIZE - 1);
 
-            listBufferArray_[back_] = element;
+            listBufferArray_[back_] = std::move(element);
+            trackAdd(back_, true);
 
             numElements_++;
 
@@ -6,6 +6,7 @@
 #include "math.h"
 
 #include "list.hpp"
+#include "list_span.hpp"
 
 namespace VCTR
 {
@@ -56,6 +57,24 @@ namespace VCTR
              */
             const T* getPtr() const;
 
+            /**
+             * @returns a view of the elements.
+             */
+            ListSpan<T> span();
+
+            /**
+             * @returns a read only view of the elements.
+             */
+            ListSpan<const T> span() const;
+
+            T *begin() { return items_; }
+
+            T *end() { return items_ + size_; }
+
+            const T *begin() const { return items_; }
+
+            const T *end() const { return items_ + size_; }
+
             /**
              * @brief Sets the pointer to the given pointer and size.
              * @param ptr 
@@ -94,6 +113,18 @@ namespace VCTR
             return items_;
         }
 
+        template <typename T>
+        ListSpan<T> ListExtern<T>::span()
+        {
+            return ListSpan<T>(items_, size_);
+        }
+
+        template <typename T>
+        ListSpan<const T> ListExtern<T>::span() const
+        {
+            return ListSpan<const T>(items_, size_);
+        }
+
         template <typename T>
         size_t ListExtern<T>::size() const
         {
@@ -0,0 +1,541 @@
+#ifndef EXVECTRCORE_LISTINTRUSIVE_HPP
+#define EXVECTRCORE_LISTINTRUSIVE_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <iterator>
+
+#include "list.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        template <typename T>
+        class ListIntrusive;
+
+        template <typename T>
+        class ListIntrusive_Iterator;
+
+        template <typename T>
+        class ListIntrusive_Cursor;
+
+        /**
+         * @brief Node of a ListIntrusive. Objects keep a node as member for each list they can be in, so linking never allocates.
+         * e.g.
+         *      class Task
+         *      {
+         *          ListIntrusive_Node<Task> listNode_{this};
+         *      };
+         *
+         * @note Nodes unlink themselves on destruction, but the list size is only correct if they were removed through the list.
+         * @tparam T Type of object the node belongs to.
+         */
+        template <typename T>
+        class ListIntrusive_Node
+        {
+            friend ListIntrusive<T>;
+            friend ListIntrusive_Iterator<T>;
+            friend ListIntrusive_Cursor<T>;
+
+        private:
+            ListIntrusive_Node *next_ = nullptr;
+            ListIntrusive_Node *prev_ = nullptr;
+            T *item_ = nullptr;
+
+        public:
+            /**
+             * @param item Object this node belongs to. Usually this.
+             */
+            ListIntrusive_Node(T *item = nullptr) : item_(item) {}
+
+            ~ListIntrusive_Node()
+            {
+                if (next_ != nullptr)
+                {
+                    prev_->next_ = next_;
+                    next_->prev_ = prev_;
+                }
+            }
+
+            // Links belong to the list, not the object, so nodes cannot be copied.
+            ListIntrusive_Node(const ListIntrusive_Node &) = delete;
+
+            ListIntrusive_Node &operator=(const ListIntrusive_Node &) = delete;
+
+            /**
+             * @returns the object this node belongs to.
+             */
+            T *getItem() const { return item_; }
+
+            /**
+             * @brief Sets the object this node belongs to.
+             */
+            void setItem(T *item) { item_ = item; }
+
+            /**
+             * @returns true if the node is in a list.
+             */
+            bool isLinked() const { return next_ != nullptr; }
+        };
+
+        /**
+         * @brief Iterates over a ListIntrusive. The next node is read before the current one is visited,
+         * so the current node can be removed (or its object destroyed) while iterating. Other nodes must not be removed, use ListIntrusive_Cursor for that.
+         * @tparam T Type of objects in list.
+         */
+        template <typename T>
+        class ListIntrusive_Iterator
+        {
+        private:
+            ListIntrusive_Node<T> *node_ = nullptr;
+            ListIntrusive_Node<T> *next_ = nullptr;
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T *value_type;
+            typedef ptrdiff_t difference_type;
+            typedef T **pointer;
+            typedef T *reference;
+
+            ListIntrusive_Iterator() {}
+
+            ListIntrusive_Iterator(ListIntrusive_Node<T> *node, ListIntrusive_Node<T> *next) : node_(node), next_(next) {}
+
+            T *operator*() const { return node_->getItem(); }
+
+            ListIntrusive_Iterator &operator++();
+
+            ListIntrusive_Iterator operator++(int)
+            {
+                ListIntrusive_Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const ListIntrusive_Iterator &other) const { return node_ == other.node_; }
+
+            bool operator!=(const ListIntrusive_Iterator &other) const { return node_ != other.node_; }
+        };
+
+        /**
+         * @brief Walks a ListIntrusive while any of its nodes may be removed, e.g. by the object being visited.
+         * The cursor is registered with the list while it exists, and removing a node through the list moves the cursor past it.
+         * Cursors of the same list can be nested, e.g. when visiting a node walks the list again.
+         * e.g.
+         *      ListIntrusive_Cursor<Task> cursor(list);
+         *      while (ListIntrusive_Node<Task> *node = cursor.next())
+         *          node->getItem()->run();
+         *
+         * @note Nodes must be removed through the list, not by destroying them while linked. The cursor must not outlive the list.
+         * @tparam T Type of objects in list.
+         */
+        template <typename T>
+        class ListIntrusive_Cursor
+        {
+            friend ListIntrusive<T>;
+
+        private:
+            ListIntrusive<T> &list_;
+            // Node returned by the next call to next(). End node of the list once done.
+            ListIntrusive_Node<T> *next_;
+            // Node last returned by next(). nullptr if it was removed since.
+            ListIntrusive_Node<T> *current_ = nullptr;
+            // Next cursor registered with the same list.
+            ListIntrusive_Cursor *outer_;
+
+        public:
+            /**
+             * @brief Starts at the first node.
+             * @param list List to walk.
+             */
+            ListIntrusive_Cursor(ListIntrusive<T> &list);
+
+            /**
+             * @param list List to walk.
+             * @param start Node in list to start at. nullptr starts at the end, so nothing is visited.
+             */
+            ListIntrusive_Cursor(ListIntrusive<T> &list, ListIntrusive_Node<T> *start);
+
+            ~ListIntrusive_Cursor();
+
+            ListIntrusive_Cursor(const ListIntrusive_Cursor &) = delete;
+
+            ListIntrusive_Cursor &operator=(const ListIntrusive_Cursor &) = delete;
+
+            /**
+             * @brief Moves to the next node.
+             * @returns next node. nullptr once all nodes were visited.
+             */
+            ListIntrusive_Node<T> *next();
+
+            /**
+             * @returns node last returned by next(). nullptr if it was removed from the list since.
+             */
+            ListIntrusive_Node<T> *getCurrent() const { return current_; }
+        };
+
+        /**
+         * @brief Doubly linked list of objects that hold their own ListIntrusive_Node. Keeps head, tail and size,
+         * so pushing, popping, removing, size() and splicing a whole list are all O(1). Never allocates.
+         * Indexing through the List interface walks the list and is O(n), iterate with begin() and end() instead.
+         * @note The list is circular around a node inside the list object, so it cannot be copied or moved while holding nodes.
+         * @tparam T Type of objects in list.
+         */
+        template <typename T>
+        class ListIntrusive : public List<T *>
+        {
+            friend ListIntrusive_Cursor<T>;
+
+        private:
+            // Before the first and after the last node. Its links are head and tail.
+            ListIntrusive_Node<T> end_;
+            size_t size_ = 0;
+            // Cursors walking this list, innermost first.
+            ListIntrusive_Cursor<T> *cursors_ = nullptr;
+
+        public:
+            ListIntrusive();
+
+            ~ListIntrusive();
+
+            ListIntrusive(const ListIntrusive &) = delete;
+
+            ListIntrusive &operator=(const ListIntrusive &) = delete;
+
+            /**
+             * @note O(1).
+             * @returns number of nodes in list.
+             */
+            size_t size() const override;
+
+            /**
+             * @returns true if the list has no nodes.
+             */
+            bool isEmpty() const;
+
+            /**
+             * @returns first node. nullptr if empty.
+             */
+            ListIntrusive_Node<T> *getFirst() const;
+
+            /**
+             * @returns last node. nullptr if empty.
+             */
+            ListIntrusive_Node<T> *getLast() const;
+
+            /**
+             * @param node Node in this list.
+             * @returns node after the given one. nullptr if it is the last.
+             */
+            ListIntrusive_Node<T> *getNext(const ListIntrusive_Node<T> *node) const;
+
+            /**
+             * @param node Node in this list.
+             * @returns node before the given one. nullptr if it is the first.
+             */
+            ListIntrusive_Node<T> *getPrev(const ListIntrusive_Node<T> *node) const;
+
+            /**
+             * @brief Adds a node to the front. The node must not be in a list.
+             */
+            void pushFront(ListIntrusive_Node<T> &node);
+
+            /**
+             * @brief Adds a node to the back. The node must not be in a list.
+             */
+            void pushBack(ListIntrusive_Node<T> &node);
+
+            /**
+             * @brief Inserts a node before position. The node must not be in a list.
+             * @param position Node in this list. nullptr inserts at the back.
+             * @param node Node to insert.
+             */
+            void insertBefore(ListIntrusive_Node<T> *position, ListIntrusive_Node<T> &node);
+
+            /**
+             * @brief Removes and returns the first node.
+             * @returns removed node. nullptr if empty.
+             */
+            ListIntrusive_Node<T> *popFront();
+
+            /**
+             * @brief Removes and returns the last node.
+             * @returns removed node. nullptr if empty.
+             */
+            ListIntrusive_Node<T> *popBack();
+
+            /**
+             * @brief Removes a node from this list. Cursors on the node move past it.
+             * @param node Node to remove. Must be in this list.
+             * @returns false if the node was not in a list.
+             */
+            bool remove(ListIntrusive_Node<T> &node);
+
+            /**
+             * @brief Moves all nodes of other to the back of this list. other is empty afterwards and its cursors are done.
+             * @param other List to take nodes from.
+             */
+            void splice(ListIntrusive &other);
+
+            /**
+             * @brief Removes all nodes.
+             * @note O(n) as every node is unlinked.
+             */
+            void clear();
+
+            /**
+             * @note O(n). Iterate with begin() and end() instead.
+             * @returns object of node at given index.
+             */
+            T *&operator[](size_t index) override;
+
+            /**
+             * @note O(n). Iterate with begin() and end() instead.
+             * @returns object of node at given index.
+             */
+            T *const &operator[](size_t index) const override;
+
+            ListIntrusive_Iterator<T> begin() const { return ListIntrusive_Iterator<T>(end_.next_, end_.next_->next_); }
+
+            ListIntrusive_Iterator<T> end() const { return ListIntrusive_Iterator<T>(const_cast<ListIntrusive_Node<T> *>(&end_), nullptr); }
+
+        private:
+            void link(ListIntrusive_Node<T> *prev, ListIntrusive_Node<T> &node);
+
+            void unlink(ListIntrusive_Node<T> &node);
+
+            ListIntrusive_Node<T> *toNode(ListIntrusive_Node<T> *node) const;
+        };
+
+        template <typename T>
+        ListIntrusive_Iterator<T> &ListIntrusive_Iterator<T>::operator++()
+        {
+            node_ = next_;
+            next_ = node_->next_;
+            return *this;
+        }
+
+        template <typename T>
+        ListIntrusive_Cursor<T>::ListIntrusive_Cursor(ListIntrusive<T> &list) : ListIntrusive_Cursor(list, list.getFirst()) {}
+
+        template <typename T>
+        ListIntrusive_Cursor<T>::ListIntrusive_Cursor(ListIntrusive<T> &list, ListIntrusive_Node<T> *start) : list_(list)
+        {
+            next_ = start != nullptr ? start : &list.end_;
+            outer_ = list.cursors_;
+            list.cursors_ = this;
+        }
+
+        template <typename T>
+        ListIntrusive_Cursor<T>::~ListIntrusive_Cursor()
+        {
+            // Usually the innermost cursor, so this finds it right away.
+            for (ListIntrusive_Cursor **cursor = &list_.cursors_; *cursor != nullptr; cursor = &(*cursor)->outer_)
+            {
+                if (*cursor == this)
+                {
+                    *cursor = outer_;
+                    break;
+                }
+            }
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive_Cursor<T>::next()
+        {
+            current_ = list_.toNode(next_);
+            if (current_ != nullptr)
+                next_ = current_->next_;
+            return current_;
+        }
+
+        template <typename T>
+        ListIntrusive<T>::ListIntrusive()
+        {
+            end_.next_ = &end_;
+            end_.prev_ = &end_;
+        }
+
+        template <typename T>
+        ListIntrusive<T>::~ListIntrusive()
+        {
+            clear();
+            // Keeps end_ from unlinking itself.
+            end_.next_ = nullptr;
+        }
+
+        template <typename T>
+        size_t ListIntrusive<T>::size() const
+        {
+            return size_;
+        }
+
+        template <typename T>
+        bool ListIntrusive<T>::isEmpty() const
+        {
+            return size_ == 0;
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::toNode(ListIntrusive_Node<T> *node) const
+        {
+            return node == &end_ ? nullptr : node;
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::getFirst() const
+        {
+            return toNode(end_.next_);
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::getLast() const
+        {
+            return toNode(end_.prev_);
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::getNext(const ListIntrusive_Node<T> *node) const
+        {
+            return toNode(node->next_);
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::getPrev(const ListIntrusive_Node<T> *node) const
+        {
+            return toNode(node->prev_);
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::link(ListIntrusive_Node<T> *prev, ListIntrusive_Node<T> &node)
+        {
+            node.prev_ = prev;
+            node.next_ = prev->next_;
+            prev->next_->prev_ = &node;
+            prev->next_ = &node;
+            size_++;
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::unlink(ListIntrusive_Node<T> &node)
+        {
+            for (ListIntrusive_Cursor<T> *cursor = cursors_; cursor != nullptr; cursor = cursor->outer_)
+            {
+                if (cursor->next_ == &node)
+                    cursor->next_ = node.next_;
+                if (cursor->current_ == &node)
+                    cursor->current_ = nullptr;
+            }
+
+            node.prev_->next_ = node.next_;
+            node.next_->prev_ = node.prev_;
+            node.next_ = nullptr;
+            node.prev_ = nullptr;
+            size_--;
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::pushFront(ListIntrusive_Node<T> &node)
+        {
+            link(&end_, node);
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::pushBack(ListIntrusive_Node<T> &node)
+        {
+            link(end_.prev_, node);
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::insertBefore(ListIntrusive_Node<T> *position, ListIntrusive_Node<T> &node)
+        {
+            if (position == nullptr)
+                position = &end_;
+            link(position->prev_, node);
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::popFront()
+        {
+            ListIntrusive_Node<T> *node = getFirst();
+            if (node != nullptr)
+                unlink(*node);
+            return node;
+        }
+
+        template <typename T>
+        ListIntrusive_Node<T> *ListIntrusive<T>::popBack()
+        {
+            ListIntrusive_Node<T> *node = getLast();
+            if (node != nullptr)
+                unlink(*node);
+            return node;
+        }
+
+        template <typename T>
+        bool ListIntrusive<T>::remove(ListIntrusive_Node<T> &node)
+        {
+            if (!node.isLinked())
+                return false;
+
+            unlink(node);
+            return true;
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::splice(ListIntrusive &other)
+        {
+            if (&other == this || other.size_ == 0)
+                return;
+
+            ListIntrusive_Node<T> *first = other.end_.next_;
+            ListIntrusive_Node<T> *last = other.end_.prev_;
+
+            first->prev_ = end_.prev_;
+            end_.prev_->next_ = first;
+            last->next_ = &end_;
+            end_.prev_ = last;
+            size_ += other.size_;
+
+            other.end_.next_ = &other.end_;
+            other.end_.prev_ = &other.end_;
+            other.size_ = 0;
+
+            for (ListIntrusive_Cursor<T> *cursor = other.cursors_; cursor != nullptr; cursor = cursor->outer_)
+                cursor->next_ = &other.end_;
+        }
+
+        template <typename T>
+        void ListIntrusive<T>::clear()
+        {
+            while (popFront() != nullptr)
+                ;
+        }
+
+        template <typename T>
+        T *&ListIntrusive<T>::operator[](size_t index)
+        {
+            ListIntrusive_Node<T> *node = end_.next_;
+            for (size_t i = 0; i < index && node != &end_; i++)
+                node = node->next_;
+            return node->item_;
+        }
+
+        template <typename T>
+        T *const &ListIntrusive<T>::operator[](size_t index) const
+        {
+            const ListIntrusive_Node<T> *node = end_.next_;
+            for (size_t i = 0; i < index && node != &end_; i++)
+                node = node->next_;
+            return node->item_;
+        }
+
+    }
+
+}
+
+#endif
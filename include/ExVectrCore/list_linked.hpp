@@ -265,18 +265,20 @@ namespace VCTR
                 next = next->next_;
             }
 
+            ListLinked *after = next->next_;
+
             if (prev != nullptr)
             {
-                prev->next_ = next->next_;
+                prev->next_ = after;
             }
 
-            next->prev_ = nullptr;
-            next->next_ = nullptr;
-
-            if (next->next_ != nullptr)
+            if (after != nullptr)
             {
-                next->next_->prev_ = prev;
+                after->prev_ = prev;
             }
+
+            next->prev_ = nullptr;
+            next->next_ = nullptr;
         }
 
         template <typename T>
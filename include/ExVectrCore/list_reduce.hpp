@@ -0,0 +1,79 @@
+#ifndef EXVECTRCORE_LISTREDUCE_HPP
+#define EXVECTRCORE_LISTREDUCE_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Reductions over contiguous elements, e.g. from ListArray::span(), ListStatic::span() or ListBuffer::getSegments().
+         * The float overloads use SIMD if the compiler targets it: AVX if __AVX__ is defined, else SSE on x86, else NEON if __ARM_NEON is defined.
+         * Otherwise, or if EXVECTR_SIMD_DISABLE is defined, they use scalar loops with multiple accumulators.
+         * Other types use the generic templates, which only need operator+, operator-, operator* and operator<.
+         * @note SIMD versions add in a different order, so float results can differ from a plain loop in the last bits.
+         */
+
+        /**
+         * @returns sum of all elements. 0 if size is 0.
+         */
+        template <typename T>
+        T reduceSum(const T *data, size_t size)
+        {
+            T sum = 0;
+            for (size_t i = 0; i < size; i++)
+                sum = sum + data[i];
+            return sum;
+        }
+
+        /**
+         * @brief Updates min and max with the elements. Initialise both with any element before the first call.
+         * Can be called once per segment to reduce multiple segments.
+         */
+        template <typename T>
+        void reduceMinMax(const T *data, size_t size, T &min, T &max)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                if (data[i] < min)
+                    min = data[i];
+                if (max < data[i])
+                    max = data[i];
+            }
+        }
+
+        /**
+         * @returns sum of squared differences of all elements from mean. Divide by count - 1 for the sample variance.
+         */
+        template <typename T>
+        T reduceSquaredDeviation(const T *data, size_t size, const T &mean)
+        {
+            T sum = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                T diff = data[i] - mean;
+                sum = sum + diff * diff;
+            }
+            return sum;
+        }
+
+        float reduceSum(const float *data, size_t size);
+
+        void reduceMinMax(const float *data, size_t size, float &min, float &max);
+
+        float reduceSquaredDeviation(const float *data, size_t size, const float &mean);
+
+        /**
+         * @returns name of the instruction set used by the float reductions: "avx", "sse", "neon" or "scalar".
+         */
+        const char *getReduceKernelName();
+
+    }
+
+}
+
+#endif
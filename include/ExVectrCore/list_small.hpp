@@ -0,0 +1,88 @@
+#ifndef EXVECTRCORE_LISTSMALL_HPP
+#define EXVECTRCORE_LISTSMALL_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <utility>
+
+#include "list_array.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * A ListArray that stores up to N items inside itself and only uses the allocator once it holds more.
+         * Use for lists that usually stay small (e.g. subscriber or port lists), so they never touch the heap.
+         * Has the same interface as ListArray and can be passed as one.
+         * @param TYPE type of data to store in ListSmall
+         * @param N Number of items stored without allocating.
+         */
+        template <typename TYPE, size_t N>
+        class ListSmall : public ListArray<TYPE>
+        {
+            static_assert(N > 0, "ListSmall needs space for at least one item. Use ListArray otherwise.");
+
+        private:
+            // Inline storage. Items are only constructed up to size().
+            alignas(TYPE) uint8_t inlineStorage_[N * sizeof(TYPE)];
+
+        public:
+            /**
+             * @param sizeControl if set to true then the internal size is reduced (down to N) when less than half used. Defaults to false.
+             */
+            ListSmall(bool sizeControl = false) : ListArray<TYPE>(reinterpret_cast<TYPE *>(inlineStorage_), N, getHeapAllocator(), sizeControl) {}
+
+            /**
+             * @param allocator Allocator to take memory from when holding more than N items. Must outlive this ListSmall.
+             * @param sizeControl if set to true then the internal size is reduced (down to N) when less than half used. Defaults to false.
+             */
+            ListSmall(Allocator &allocator, bool sizeControl = false) : ListArray<TYPE>(reinterpret_cast<TYPE *>(inlineStorage_), N, allocator, sizeControl) {}
+
+            ListSmall(const ListSmall &other) : ListArray<TYPE>(reinterpret_cast<TYPE *>(inlineStorage_), N, other.getAllocator(), false)
+            {
+                ListArray<TYPE>::operator=(other);
+            }
+
+            ListSmall(ListSmall &&other) : ListArray<TYPE>(reinterpret_cast<TYPE *>(inlineStorage_), N, other.getAllocator(), false)
+            {
+                ListArray<TYPE>::operator=(std::move(other));
+            }
+
+            ~ListSmall()
+            {
+                // Items in the inline storage must be destroyed before it is.
+                this->clearItems();
+            }
+
+            using ListArray<TYPE>::operator=;
+
+            ListSmall &operator=(const ListSmall &other)
+            {
+                ListArray<TYPE>::operator=(other);
+                return *this;
+            }
+
+            ListSmall &operator=(ListSmall &&other)
+            {
+                ListArray<TYPE>::operator=(std::move(other));
+                return *this;
+            }
+
+            /**
+             * @returns true if the items are stored inside this object and not in allocated memory.
+             */
+            bool isInline() const
+            {
+                return this->getPtr() == reinterpret_cast<const TYPE *>(inlineStorage_);
+            }
+        };
+
+    }
+
+}
+
+#endif
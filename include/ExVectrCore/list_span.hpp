@@ -0,0 +1,208 @@
+#ifndef EXVECTRCORE_LISTSPAN_HPP
+#define EXVECTRCORE_LISTSPAN_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <iterator>
+#include <type_traits>
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Non owning view of contiguous elements. Unlike List, nothing is virtual, so loops over a span compile to plain pointer loops
+         * and work with range-for and the standard algorithms.
+         * e.g.
+         *      for (float &value : listArray.span()) value *= 2;
+         *      std::sort(listStatic.begin(), listStatic.end());
+         *
+         * @note The view is invalidated if the list it was taken from reallocates or changes size.
+         * @tparam T Type of elements. Use const T for a read only view.
+         */
+        template <typename T>
+        class ListSpan
+        {
+        private:
+            T *data_ = nullptr;
+            size_t size_ = 0;
+
+        public:
+            typedef T value_type;
+            typedef T *iterator;
+
+            /**
+             * @brief Creates an empty span.
+             */
+            ListSpan() {}
+
+            /**
+             * @param data Pointer to first element.
+             * @param size Number of elements.
+             */
+            ListSpan(T *data, size_t size) : data_(data), size_(size) {}
+
+            /**
+             * @param array Array to view.
+             */
+            template <size_t N>
+            ListSpan(T (&array)[N]) : data_(array), size_(N) {}
+
+            /**
+             * @brief Allows converting a span to a read only span.
+             */
+            template <typename U, typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+            ListSpan(const ListSpan<U> &other) : data_(other.data()), size_(other.size()) {}
+
+            /**
+             * @returns number of elements.
+             */
+            size_t size() const { return size_; }
+
+            /**
+             * @returns true if there are no elements.
+             */
+            bool isEmpty() const { return size_ == 0; }
+
+            /**
+             * @returns pointer to the first element.
+             */
+            T *data() const { return data_; }
+
+            T *begin() const { return data_; }
+
+            T *end() const { return data_ + size_; }
+
+            /**
+             * @returns element at given index. Not range checked.
+             */
+            T &operator[](size_t index) const { return data_[index]; }
+
+            /**
+             * @returns view of count elements starting at offset. Clamped to this span.
+             */
+            ListSpan subspan(size_t offset, size_t count = SIZE_MAX) const
+            {
+                if (offset > size_)
+                    offset = size_;
+                if (count > size_ - offset)
+                    count = size_ - offset;
+                return ListSpan(data_ + offset, count);
+            }
+        };
+
+        /**
+         * @brief View of elements stored in two contiguous segments, as in a ring buffer that wrapped around.
+         * Algorithms that do not care about order (sums, min/max, copying) should loop over first and second directly,
+         * the iterator joins both for range-for and standard algorithms.
+         * @tparam T Type of elements. Use const T for a read only view.
+         */
+        template <typename T>
+        class ListSpanPair
+        {
+        public:
+            /**
+             * @brief Iterates over first, then second.
+             */
+            class Iterator
+            {
+            private:
+                T *current_ = nullptr;
+                T *firstEnd_ = nullptr;
+                T *secondBegin_ = nullptr;
+                // Needed as the end of second can be the begin of first in a full ring buffer.
+                bool inSecond_ = false;
+
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef typename std::remove_const<T>::type value_type;
+                typedef ptrdiff_t difference_type;
+                typedef T *pointer;
+                typedef T &reference;
+
+                Iterator() {}
+
+                Iterator(T *current, T *firstEnd, T *secondBegin, bool inSecond) : current_(current), firstEnd_(firstEnd), secondBegin_(secondBegin), inSecond_(inSecond)
+                {
+                    if (!inSecond_ && current_ == firstEnd_)
+                    {
+                        current_ = secondBegin_;
+                        inSecond_ = true;
+                    }
+                }
+
+                T &operator*() const { return *current_; }
+
+                T *operator->() const { return current_; }
+
+                Iterator &operator++()
+                {
+                    if (++current_ == firstEnd_ && !inSecond_)
+                    {
+                        current_ = secondBegin_;
+                        inSecond_ = true;
+                    }
+                    return *this;
+                }
+
+                Iterator operator++(int)
+                {
+                    Iterator copy = *this;
+                    ++(*this);
+                    return copy;
+                }
+
+                bool operator==(const Iterator &other) const { return current_ == other.current_ && inSecond_ == other.inSecond_; }
+
+                bool operator!=(const Iterator &other) const { return !(*this == other); }
+            };
+
+            typedef T value_type;
+            typedef Iterator iterator;
+
+            /// @brief Elements before the wrap around.
+            ListSpan<T> first;
+            /// @brief Elements after the wrap around. Empty if the elements did not wrap.
+            ListSpan<T> second;
+
+            ListSpanPair() {}
+
+            ListSpanPair(const ListSpan<T> &firstSegment, const ListSpan<T> &secondSegment) : first(firstSegment), second(secondSegment) {}
+
+            /**
+             * @brief Allows converting to a read only view.
+             */
+            template <typename U, typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+            ListSpanPair(const ListSpanPair<U> &other) : first(other.first), second(other.second) {}
+
+            /**
+             * @returns number of elements in both segments.
+             */
+            size_t size() const { return first.size() + second.size(); }
+
+            /**
+             * @returns true if there are no elements.
+             */
+            bool isEmpty() const { return size() == 0; }
+
+            /**
+             * @returns element at given index, counting through first then second. Not range checked.
+             */
+            T &operator[](size_t index) const
+            {
+                return index < first.size() ? first[index] : second[index - first.size()];
+            }
+
+            Iterator begin() const { return Iterator(first.begin(), first.end(), second.begin(), false); }
+
+            Iterator end() const { return Iterator(second.end(), first.end(), second.begin(), true); }
+        };
+
+    }
+
+}
+
+#endif
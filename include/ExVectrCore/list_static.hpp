@@ -6,6 +6,7 @@
 #include "math.h"
 
 #include "list.hpp"
+#include "list_span.hpp"
 
 namespace VCTR
 {
@@ -44,6 +45,24 @@ namespace VCTR
              */
             const T* getPtr() const;
 
+            /**
+             * @returns a view of the elements.
+             */
+            ListSpan<T> span();
+
+            /**
+             * @returns a read only view of the elements.
+             */
+            ListSpan<const T> span() const;
+
+            T *begin() { return items_; }
+
+            T *end() { return items_ + L; }
+
+            const T *begin() const { return items_; }
+
+            const T *end() const { return items_ + L; }
+
             /**
              * @returns item at given index.
              */
@@ -75,6 +94,18 @@ namespace VCTR
             return items_;
         }
 
+        template <typename T, size_t L>
+        ListSpan<T> ListStatic<T, L>::span()
+        {
+            return ListSpan<T>(items_, L);
+        }
+
+        template <typename T, size_t L>
+        ListSpan<const T> ListStatic<T, L>::span() const
+        {
+            return ListSpan<const T>(items_, L);
+        }
+
         template <typename T, size_t L>
         size_t ListStatic<T, L>::size() const
         {
@@ -0,0 +1,98 @@
+#ifndef EXVECTRCORE_RUNNINGSTATISTICS_HPP
+#define EXVECTRCORE_RUNNINGSTATISTICS_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Statistics of a set of values that are updated as values are added and removed, so sum, mean and variance of a sliding window are O(1).
+         * The sum is Kahan compensated and the variance uses Welford's update, so long running windows do not drift.
+         * Min and max are kept while only adding. Removing the current min or max invalidates them until setExtremes() is called, as ListBuffer does from its min and max queues.
+         */
+        class RunningStatistics
+        {
+        private:
+            size_t count_ = 0;
+
+            double sum_ = 0;
+            /// @brief Low order bits lost in sum_.
+            double sumCompensation_ = 0;
+
+            double mean_ = 0;
+            /// @brief Sum of squared differences from the mean.
+            double m2_ = 0;
+
+            double min_ = 0;
+            double max_ = 0;
+            bool extremesValid_ = true;
+
+        public:
+            /**
+             * @brief Removes all values.
+             */
+            void reset();
+
+            /**
+             * @brief Adds a value to the set.
+             */
+            void add(double value);
+
+            /**
+             * @brief Removes a value that was added before.
+             */
+            void remove(double value);
+
+            /**
+             * @returns number of values in the set.
+             */
+            size_t getCount() const;
+
+            double getSum() const;
+
+            /**
+             * @returns average of all values. 0 if empty.
+             */
+            double getMean() const;
+
+            /**
+             * @returns sample variance (divided by count - 1). 0 if less than 2 values.
+             */
+            double getVariance() const;
+
+            /**
+             * @returns sample standard deviation. 0 if less than 2 values.
+             */
+            double getStandardDeviation() const;
+
+            /**
+             * @returns true if getMin() and getMax() are valid. False after the min or max was removed.
+             */
+            bool hasExtremes() const;
+
+            /**
+             * @returns smallest value. Only valid if hasExtremes() is true.
+             */
+            double getMin() const;
+
+            /**
+             * @returns largest value. Only valid if hasExtremes() is true.
+             */
+            double getMax() const;
+
+            /**
+             * @brief Sets min and max after they were invalidated, e.g. after scanning all values.
+             */
+            void setExtremes(double min, double max);
+        };
+
+    }
+
+}
+
+#endif
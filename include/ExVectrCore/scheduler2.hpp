@@ -6,7 +6,7 @@
 
 // #include "list_array.hpp"
 #include "time_definitions.hpp"
-#include "list_linked.hpp"
+#include "list_intrusive.hpp"
 #include "time_source.hpp"
 #include "time_base.hpp"
 
@@ -62,7 +62,7 @@ namespace VCTR
 
             private:
                 /// @brief Use by scheduler to iterate through all attached tasks.
-                ListLinked<Task *> taskListElement_;
+                ListIntrusive_Node<Task> taskListElement_;
                 /// @brief how many times the task has been called.
                 size_t runCounter = 0;
                 /// @brief time in ns of the last reset.
@@ -193,7 +193,7 @@ namespace VCTR
 
         private:
             /// @brief List of all tasks attached to this scheduler.
-            ListLinked<Task *> *tasks_;
+            ListIntrusive<Task> tasks_;
             /// @brief list of tasks that need to be ran sorted to their pseudo priority
             // ListArray<size_t> taskIndexRun_;
             /// @brief source of time.
@@ -219,6 +219,11 @@ namespace VCTR
              */
             Scheduler(Clock_Source &clockSource);
 
+            /**
+             * Detaches all tasks, so they can outlive the scheduler.
+             */
+            ~Scheduler();
+
             /**
              * Adds a task to the scheduler to be ran.
              * @param task The task to be added to the Scheduler.
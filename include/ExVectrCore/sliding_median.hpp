@@ -0,0 +1,354 @@
+#ifndef EXVECTRCORE_SLIDINGMEDIAN_HPP
+#define EXVECTRCORE_SLIDINGMEDIAN_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <utility>
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Two heaps over slots of an external values array, the lower half in a max heap and the upper half in a min heap, so the median is always at their tops.
+         * Each slot remembers its position in the heaps, so any slot can be removed in O(log SIZE). The values are passed to every call, so the owner can be copied.
+         * A slot's value must not change while it is in the heaps.
+         * @see SlidingMedian
+         *
+         * @tparam T Type of values. Needs operator<. For even counts, operator+ and division by 2 are used to average the middle values.
+         * @tparam SIZE Number of slots.
+         */
+        template <typename T, size_t SIZE>
+        class SlidingMedian_Heaps
+        {
+            static_assert(SIZE > 0, "SlidingMedian_Heaps needs space for at least one slot.");
+
+        private:
+            static constexpr uint8_t LOWER = 0;
+            static constexpr uint8_t UPPER = 1;
+
+            // Heap each slot is in and its position there.
+            uint8_t heapOf_[SIZE];
+            size_t heapPosition_[SIZE];
+
+            // Slots. LOWER is a max heap, UPPER a min heap. LOWER holds as many or one more than UPPER.
+            size_t heaps_[2][SIZE];
+            size_t heapSize_[2] = {0, 0};
+
+        public:
+            SlidingMedian_Heaps() {}
+
+            /**
+             * @brief Adds a slot. Its value must already be written.
+             * @param values Values array of SIZE.
+             * @param slot Slot to add. Must not be in the heaps.
+             */
+            void insert(const T *values, size_t slot);
+
+            /**
+             * @brief Removes a slot. Its value must be unchanged since it was added.
+             * @param values Values array of SIZE.
+             * @param slot Slot to remove. Must be in the heaps.
+             */
+            void remove(const T *values, size_t slot);
+
+            /**
+             * @param values Values array of SIZE.
+             * @returns median of all slots. Average of the two middle values if the count is even. T() if empty.
+             */
+            T getMedian(const T *values) const;
+
+            /**
+             * @returns number of slots in the heaps.
+             */
+            size_t size() const;
+
+            /**
+             * @brief Removes all slots.
+             */
+            void clear();
+
+        private:
+            /**
+             * @returns true if slot a belongs above slot b in the given heap.
+             */
+            bool above(const T *values, uint8_t heap, size_t a, size_t b) const;
+
+            void setPosition(uint8_t heap, size_t position, size_t slot);
+
+            void siftUp(const T *values, uint8_t heap, size_t position);
+
+            void siftDown(const T *values, uint8_t heap, size_t position);
+
+            void push(const T *values, uint8_t heap, size_t slot);
+
+            /**
+             * @brief Removes the slot at the given heap position.
+             * @returns the removed slot.
+             */
+            size_t removeAt(const T *values, uint8_t heap, size_t position);
+
+            /**
+             * @brief Moves top slots between heaps until LOWER holds as many or one more than UPPER.
+             */
+            void rebalance(const T *values);
+        };
+
+        /**
+         * @brief Median of the last SIZE values placed, updated in O(log SIZE) per value.
+         * Values are kept in SlidingMedian_Heaps, so the oldest one can be removed directly once the window is full.
+         * e.g. filtering spikes out of a sensor:
+         *      SlidingMedian<float, 32> median;
+         *      median.place(sample);
+         *      float filtered = median.getMedian();
+         * @see ListBuffer with LISTBUFFER_MEDIAN for the same over a ListBuffer.
+         *
+         * @tparam T Type of values. Needs operator<. For even counts, operator+ and division by 2 are used to average the middle values.
+         * @tparam SIZE Number of values in the window.
+         */
+        template <typename T, size_t SIZE>
+        class SlidingMedian
+        {
+            static_assert(SIZE > 0, "SlidingMedian needs space for at least one value.");
+
+        private:
+            // Values in order of placing. Ring buffer, oldest at next_ once full.
+            T values_[SIZE];
+            SlidingMedian_Heaps<T, SIZE> heaps_;
+
+            // Slot the next value is placed into.
+            size_t next_ = 0;
+            size_t numValues_ = 0;
+
+        public:
+            SlidingMedian() {}
+
+            /**
+             * @brief Places a new value. If full, the oldest value is removed.
+             * @param value Value to place.
+             */
+            void place(const T &value);
+
+            /**
+             * @brief Removes the oldest value.
+             * @returns false if empty.
+             */
+            bool removeOldest();
+
+            /**
+             * @returns median of all values. Average of the two middle values if the count is even. T() if empty.
+             */
+            T getMedian() const;
+
+            /**
+             * @returns number of values.
+             */
+            size_t size() const;
+
+            /**
+             * @returns number of values in a full window.
+             */
+            size_t sizeMax() const;
+
+            /**
+             * @brief Removes all values.
+             */
+            void clear();
+        };
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::insert(const T *values, size_t slot)
+        {
+            if (heapSize_[LOWER] == 0 || !(values[heaps_[LOWER][0]] < values[slot]))
+                push(values, LOWER, slot);
+            else
+                push(values, UPPER, slot);
+
+            rebalance(values);
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::remove(const T *values, size_t slot)
+        {
+            removeAt(values, heapOf_[slot], heapPosition_[slot]);
+            rebalance(values);
+        }
+
+        template <typename T, size_t SIZE>
+        T SlidingMedian_Heaps<T, SIZE>::getMedian(const T *values) const
+        {
+            if (heapSize_[LOWER] == 0)
+                return T();
+
+            const T &lower = values[heaps_[LOWER][0]];
+            if (heapSize_[LOWER] != heapSize_[UPPER])
+                return lower;
+
+            return (lower + values[heaps_[UPPER][0]]) / 2;
+        }
+
+        template <typename T, size_t SIZE>
+        size_t SlidingMedian_Heaps<T, SIZE>::size() const
+        {
+            return heapSize_[LOWER] + heapSize_[UPPER];
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::clear()
+        {
+            heapSize_[LOWER] = 0;
+            heapSize_[UPPER] = 0;
+        }
+
+        template <typename T, size_t SIZE>
+        bool SlidingMedian_Heaps<T, SIZE>::above(const T *values, uint8_t heap, size_t a, size_t b) const
+        {
+            if (heap == LOWER)
+                return values[b] < values[a];
+            return values[a] < values[b];
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::setPosition(uint8_t heap, size_t position, size_t slot)
+        {
+            heaps_[heap][position] = slot;
+            heapOf_[slot] = heap;
+            heapPosition_[slot] = position;
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::siftUp(const T *values, uint8_t heap, size_t position)
+        {
+            size_t slot = heaps_[heap][position];
+
+            while (position > 0)
+            {
+                size_t parent = (position - 1) / 2;
+                if (!above(values, heap, slot, heaps_[heap][parent]))
+                    break;
+                setPosition(heap, position, heaps_[heap][parent]);
+                position = parent;
+            }
+
+            setPosition(heap, position, slot);
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::siftDown(const T *values, uint8_t heap, size_t position)
+        {
+            size_t slot = heaps_[heap][position];
+            size_t size = heapSize_[heap];
+
+            while (true)
+            {
+                size_t child = 2 * position + 1;
+                if (child >= size)
+                    break;
+                if (child + 1 < size && above(values, heap, heaps_[heap][child + 1], heaps_[heap][child]))
+                    child++;
+                if (!above(values, heap, heaps_[heap][child], slot))
+                    break;
+                setPosition(heap, position, heaps_[heap][child]);
+                position = child;
+            }
+
+            setPosition(heap, position, slot);
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::push(const T *values, uint8_t heap, size_t slot)
+        {
+            size_t position = heapSize_[heap]++;
+            setPosition(heap, position, slot);
+            siftUp(values, heap, position);
+        }
+
+        template <typename T, size_t SIZE>
+        size_t SlidingMedian_Heaps<T, SIZE>::removeAt(const T *values, uint8_t heap, size_t position)
+        {
+            size_t slot = heaps_[heap][position];
+            size_t last = --heapSize_[heap];
+
+            if (position != last)
+            {
+                // Fill the gap with the last slot, which may need to move either way.
+                size_t moved = heaps_[heap][last];
+                setPosition(heap, position, moved);
+                siftUp(values, heap, position);
+                siftDown(values, heap, heapPosition_[moved]);
+            }
+
+            return slot;
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian_Heaps<T, SIZE>::rebalance(const T *values)
+        {
+            if (heapSize_[LOWER] > heapSize_[UPPER] + 1)
+                push(values, UPPER, removeAt(values, LOWER, 0));
+            else if (heapSize_[UPPER] > heapSize_[LOWER])
+                push(values, LOWER, removeAt(values, UPPER, 0));
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian<T, SIZE>::place(const T &value)
+        {
+            if (numValues_ == SIZE)
+                removeOldest();
+
+            size_t slot = next_;
+            next_ = next_ + 1 == SIZE ? 0 : next_ + 1;
+            numValues_++;
+
+            values_[slot] = value;
+            heaps_.insert(values_, slot);
+        }
+
+        template <typename T, size_t SIZE>
+        bool SlidingMedian<T, SIZE>::removeOldest()
+        {
+            if (numValues_ == 0)
+                return false;
+
+            size_t slot = next_ >= numValues_ ? next_ - numValues_ : next_ + SIZE - numValues_;
+            numValues_--;
+
+            heaps_.remove(values_, slot);
+
+            return true;
+        }
+
+        template <typename T, size_t SIZE>
+        T SlidingMedian<T, SIZE>::getMedian() const
+        {
+            return heaps_.getMedian(values_);
+        }
+
+        template <typename T, size_t SIZE>
+        size_t SlidingMedian<T, SIZE>::size() const
+        {
+            return numValues_;
+        }
+
+        template <typename T, size_t SIZE>
+        size_t SlidingMedian<T, SIZE>::sizeMax() const
+        {
+            return SIZE;
+        }
+
+        template <typename T, size_t SIZE>
+        void SlidingMedian<T, SIZE>::clear()
+        {
+            heaps_.clear();
+            next_ = 0;
+            numValues_ = 0;
+        }
+
+    }
+
+}
+
+#endif
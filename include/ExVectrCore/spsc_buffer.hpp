@@ -0,0 +1,267 @@
+#ifndef EXVECTRCORE_SPSCBUFFER_HPP
+#define EXVECTRCORE_SPSCBUFFER_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <atomic>
+#include <utility>
+
+#ifndef EXVECTR_CACHE_LINE_SIZE
+/// @brief Used to place data written by different threads onto separate cache lines.
+#define EXVECTR_CACHE_LINE_SIZE 64
+#endif
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Wait free ring buffer for exactly one producer and one consumer thread (or ISR and main loop).
+         * The producer only writes the head index and the consumer only writes the tail index, each on its own cache line,
+         * so neither side ever waits for the other. Indices run freely and are masked, therefore SIZE must be a power of two.
+         * All SIZE slots are usable.
+         *
+         * Producer side: placeFront(), placeFrontN(), isFull().
+         * Consumer side: takeBack(), takeBackN(), peekBack(), removeBack(), clear().
+         * size() and isEmpty() can be called from both, but are only a snapshot.
+         *
+         * @tparam T Type of elements.
+         * @tparam SIZE Number of elements. Must be a power of two.
+         */
+        template <typename T, size_t SIZE>
+        class SPSC_Buffer
+        {
+            static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SPSC_Buffer size must be a power of two.");
+
+        private:
+            static constexpr size_t MASK = SIZE - 1;
+
+            /// @brief Index the next element is placed at. Written by producer.
+            alignas(EXVECTR_CACHE_LINE_SIZE) std::atomic<size_t> head_;
+            /// @brief Producers copy of tail. Saves reading the consumers cache line on every place.
+            size_t tailCache_ = 0;
+
+            /// @brief Index of the oldest element. Written by consumer.
+            alignas(EXVECTR_CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+            /// @brief Consumers copy of head.
+            size_t headCache_ = 0;
+
+            /// @brief Element storage.
+            alignas(EXVECTR_CACHE_LINE_SIZE) T buffer_[SIZE];
+
+        public:
+            SPSC_Buffer() : head_(0), tail_(0) {}
+
+            SPSC_Buffer(const SPSC_Buffer &) = delete;
+            SPSC_Buffer &operator=(const SPSC_Buffer &) = delete;
+
+            /**
+             * @returns number of elements. Only a snapshot if the other side is active.
+             */
+            size_t size() const
+            {
+                return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @returns How large the buffer in total is.
+             */
+            constexpr size_t sizeMax() const
+            {
+                return SIZE;
+            }
+
+            /**
+             * @returns true if empty. Only a snapshot if the producer is active.
+             */
+            bool isEmpty() const
+            {
+                return size() == 0;
+            }
+
+            /**
+             * @returns true if full. Only a snapshot if the consumer is active.
+             */
+            bool isFull() const
+            {
+                return size() == SIZE;
+            }
+
+            /**
+             * Producer only. Places an element at the front.
+             * @param element Element to place.
+             * @return false if full.
+             */
+            bool placeFront(const T &element)
+            {
+                size_t head = head_.load(std::memory_order_relaxed);
+                if (!hasSpace(head, 1))
+                    return false;
+
+                buffer_[head & MASK] = element;
+                head_.store(head + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Producer only. Moves an element to the front.
+             * @param element Element to move.
+             * @return false if full.
+             */
+            bool placeFront(T &&element)
+            {
+                size_t head = head_.load(std::memory_order_relaxed);
+                if (!hasSpace(head, 1))
+                    return false;
+
+                buffer_[head & MASK] = std::move(element);
+                head_.store(head + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Producer only. Places multiple elements at once. The consumer sees them all at the same time.
+             * @param elements Pointer to elements. Oldest first.
+             * @param numElements Number of elements to place.
+             * @return number of elements placed. Placing stops once full.
+             */
+            size_t placeFrontN(const T *elements, size_t numElements)
+            {
+                size_t head = head_.load(std::memory_order_relaxed);
+
+                size_t space = SIZE - (head - tailCache_);
+                if (space < numElements)
+                {
+                    tailCache_ = tail_.load(std::memory_order_acquire);
+                    space = SIZE - (head - tailCache_);
+                    if (space < numElements)
+                        numElements = space;
+                }
+
+                for (size_t i = 0; i < numElements; i++)
+                    buffer_[(head + i) & MASK] = elements[i];
+
+                head_.store(head + numElements, std::memory_order_release);
+
+                return numElements;
+            }
+
+            /**
+             * Consumer only. Takes the oldest element.
+             * @param element Variable whos data will be overwritten.
+             * @return false if empty.
+             */
+            bool takeBack(T &element)
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+                if (!hasElements(tail, 1))
+                    return false;
+
+                element = std::move(buffer_[tail & MASK]);
+                tail_.store(tail + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Consumer only. Takes up to maxElements of the oldest elements at once.
+             * @param elements Array to move elements into. Oldest first.
+             * @param maxElements Max number of elements to take.
+             * @return number of elements taken.
+             */
+            size_t takeBackN(T *elements, size_t maxElements)
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+
+                size_t available = headCache_ - tail;
+                if (available < maxElements)
+                {
+                    headCache_ = head_.load(std::memory_order_acquire);
+                    available = headCache_ - tail;
+                }
+                if (available > maxElements)
+                    available = maxElements;
+
+                for (size_t i = 0; i < available; i++)
+                    elements[i] = std::move(buffer_[(tail + i) & MASK]);
+
+                tail_.store(tail + available, std::memory_order_release);
+
+                return available;
+            }
+
+            /**
+             * Consumer only. Copies the oldest element without removing it.
+             * @param element Variable whos data will be overwritten.
+             * @return false if empty.
+             */
+            bool peekBack(T &element)
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+                if (!hasElements(tail, 1))
+                    return false;
+
+                element = buffer_[tail & MASK];
+
+                return true;
+            }
+
+            /**
+             * Consumer only. Removes the oldest elements.
+             * @param num Number of elements to remove. Defaults to 1.
+             */
+            void removeBack(size_t num = 1)
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+                // Tail may pass the cached head, which must never be behind it.
+                headCache_ = head_.load(std::memory_order_acquire);
+                size_t available = headCache_ - tail;
+                if (num > available)
+                    num = available;
+
+                tail_.store(tail + num, std::memory_order_release);
+            }
+
+            /**
+             * Consumer only. Removes all elements.
+             */
+            void clear()
+            {
+                headCache_ = head_.load(std::memory_order_acquire);
+                tail_.store(headCache_, std::memory_order_release);
+            }
+
+        private:
+            /**
+             * @returns true if there is space for num elements. Only reads tail if the cached value says there is not.
+             */
+            inline bool hasSpace(size_t head, size_t num)
+            {
+                if (head - tailCache_ + num <= SIZE)
+                    return true;
+                tailCache_ = tail_.load(std::memory_order_acquire);
+                return head - tailCache_ + num <= SIZE;
+            }
+
+            /**
+             * @returns true if there are at least num elements. Only reads head if the cached value says there are not.
+             */
+            inline bool hasElements(size_t tail, size_t num)
+            {
+                if (headCache_ - tail >= num)
+                    return true;
+                headCache_ = head_.load(std::memory_order_acquire);
+                return headCache_ - tail >= num;
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -2,9 +2,22 @@
 #define EXVECTRCORE_TOPIC_H
 
 #include "stddef.h"
+#include "stdint.h"
+
+#include <new>
+#include <utility>
+
 // #include "list_array.hpp"
-#include "list_linked.hpp"
+#include "list_intrusive.hpp"
 #include "list_static.hpp"
+#include "time_definitions.hpp"
+
+// Define to collect statistics of all topics and subscribers. Costs two NOW() calls per receive(). @see topic_stats.hpp
+//#define EXVECTR_TOPIC_STATS_ENABLE
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+#include "topic_stats.hpp"
+#endif
 
 namespace VCTR
 {
@@ -15,15 +28,90 @@ namespace VCTR
         template <typename TYPE>
         class Subscriber;
 
+        /**
+         * @brief Interface class for storing the latest published items of a topic.
+         * Items are given to new subscribers on subscribe() and can be polled with Topic::getLatest().
+         * @see Topic_History for an implementation.
+         */
+        template <typename TYPE>
+        class Topic_Cache
+        {
+        public:
+            virtual ~Topic_Cache() {}
+
+            /**
+             * @brief Called by topic on every publish before subscribers receive the item.
+             * @param item Published item.
+             */
+            virtual void place(const TYPE &item) = 0;
+
+            /**
+             * @brief Copies the latest item into the given variable.
+             * @param item Variable to copy latest item into.
+             * @returns false if no item has been published yet.
+             */
+            virtual bool getLatest(TYPE &item) const = 0;
+
+            /**
+             * @returns the number of items stored.
+             */
+            virtual size_t getHistorySize() const = 0;
+
+            /**
+             * @param index Index of item. 0 is the oldest item.
+             * @returns the stored item at the given index.
+             */
+            virtual const TYPE &getHistoryItem(size_t index) const = 0;
+
+            /**
+             * @brief Called by topic when it stops using this cache, because another was set or the topic is destroyed.
+             * The topic must not be accessed afterwards.
+             */
+            virtual void topicDetached() {}
+        };
+
+        /**
+         * @brief Interface class for queueing items for deferred subscribers.
+         * If a topic has a deferred queue, subscribers set as deferred do not receive items during publish.
+         * The item is placed into the queue once instead and given to them later with Topic::publishDeferred().
+         * @see Topic_Deferred_Dispatcher for an implementation.
+         */
+        template <typename TYPE>
+        class Topic_Deferred_Queue
+        {
+        public:
+            virtual ~Topic_Deferred_Queue() {}
+
+            /**
+             * @brief Called by topic on publish if there are deferred subscribers. Must not block.
+             * @param item Published item.
+             */
+            virtual void place(const TYPE &item) = 0;
+
+            /**
+             * @brief Called by topic when it stops using this queue, because another was set or the topic is destroyed.
+             * The topic must not be accessed afterwards.
+             */
+            virtual void topicDetached() {}
+        };
+
         template <typename TYPE>
         class Topic final
         {
             friend Subscriber<TYPE>;
 
         private:
-            // List of subscribers.
-            // ListArray<Subscriber_Interface<TYPE> *> subscribers_;
-            ListLinked<Subscriber<TYPE> *> *subListStart_ = nullptr;
+            // List of subscribers. Sorted by insertSubscriber().
+            ListIntrusive<Subscriber<TYPE>> subscribers_;
+            // Stores the latest items. nullptr if topic keeps no history.
+            Topic_Cache<TYPE> *cache_ = nullptr;
+            // Queues items for deferred subscribers. nullptr delivers to all subscribers during publish.
+            Topic_Deferred_Queue<TYPE> *deferredQueue_ = nullptr;
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            // Statistics of this topic.
+            TopicStats stats_{this, sizeof(TYPE)};
+#endif
 
         public:
             Topic() {}
@@ -46,6 +134,74 @@ namespace VCTR
              */
             void publish(const TYPE &item);
 
+            /**
+             * Sends item to all subscribers. The last receiving subscriber gets the item moved into it, all others a copy.
+             * With a single subscriber this saves the copy entirely.
+             * @param item Item to be sent.
+             */
+            void publish(TYPE &&item);
+
+            /**
+             * Constructs the item directly inside the storage of the first subscriber (e.g. Simple_Subscriber, Buffer_Subscriber),
+             * all other subscribers receive a copy from there. Falls back to a moved publish if the first subscriber has no storage or is filtered.
+             * @param args Arguments to construct item with.
+             */
+            template <typename... ARGS>
+            void emplace(ARGS &&...args);
+
+            /**
+             * Sends multiple items to all subscribers at once. Subscribers receive them with a single receiveBatch() call.
+             * Use for burst producers like sensor FIFOs to save the per item dispatch.
+             * @param items Pointer to items to be sent. Oldest first.
+             * @param numItems Number of items.
+             */
+            void publishBatch(const TYPE *items, size_t numItems);
+
+            /**
+             * @brief Sets where the topic stores its latest items. New subscribers receive the stored items on subscribe().
+             * @see Topic_History
+             * @param cache Cache to use. nullptr to disable.
+             */
+            void setCache(Topic_Cache<TYPE> *cache);
+
+            /**
+             * @returns the cache used by this topic. nullptr if none.
+             */
+            Topic_Cache<TYPE> *getCache() const;
+
+            /**
+             * @brief Copies the latest published item into item. Allows polling a topic without subscribing.
+             * @note Requires a cache. @see Topic_History
+             * @param item Variable to copy latest item into.
+             * @returns false if there is no cache or nothing has been published yet.
+             */
+            bool getLatest(TYPE &item) const;
+
+            /**
+             * @brief Sets the queue for deferred subscribers. @see Subscriber::setPriority()
+             * @param queue Queue to use. nullptr delivers to deferred subscribers during publish like all others.
+             */
+            void setDeferredQueue(Topic_Deferred_Queue<TYPE> *queue);
+
+            /**
+             * @returns the queue for deferred subscribers. nullptr if none.
+             */
+            Topic_Deferred_Queue<TYPE> *getDeferredQueue() const;
+
+            /**
+             * @brief Gives item to deferred subscribers only. Called by the deferred queue.
+             * @note A deferred subscriber publishing to its own topic will also receive its own item.
+             * @param item Item to be sent.
+             */
+            void publishDeferred(const TYPE &item);
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            /**
+             * @returns the statistics of this topic.
+             */
+            const TopicStats &getStats() const { return stats_; }
+#endif
+
         private:
             /**
              * Publishes copy of item to subscribers except for given subscriber.
@@ -54,7 +210,59 @@ namespace VCTR
              */
             void publish(const TYPE &item, Subscriber<TYPE> *subscriber);
 
-            // TYPE latestItem;
+            /**
+             * Publishes item to subscribers except for given subscriber. The item is moved into the last receiving subscriber.
+             * @param item Item to be sent.
+             * @param subscriber Subscriber to not receive item
+             */
+            void publish(TYPE &&item, Subscriber<TYPE> *subscriber);
+
+            /**
+             * Publishes items to subscribers except for given subscriber.
+             * @param items Pointer to items to be sent.
+             * @param numItems Number of items.
+             * @param subscriber Subscriber to not receive items
+             */
+            void publishBatch(const TYPE *items, size_t numItems, Subscriber<TYPE> *subscriber);
+
+            /**
+             * Gives item to subscribers starting at the given list element.
+             * @param next List element to start at.
+             * @param item Item to be sent.
+             * @param subscriber Subscriber to not receive item
+             */
+            void deliver(ListIntrusive_Node<Subscriber<TYPE>> *next, const TYPE &item, Subscriber<TYPE> *subscriber);
+
+            /**
+             * @returns true if the given subscriber should receive the item.
+             */
+            static bool isReceiving(Subscriber<TYPE> *sub, const TYPE &item, Subscriber<TYPE> *subscriber);
+
+            /**
+             * @returns true if the given subscriber receives items through the deferred queue instead of during publish.
+             */
+            bool isDeferred(Subscriber<TYPE> *sub) const;
+
+            /**
+             * Inserts the subscriber into the subscriber list sorted by priority. Synchronous subscribers come first, then higher priority first.
+             * Subscribers with the same priority stay in subscribing order.
+             */
+            void insertSubscriber(Subscriber<TYPE> *sub);
+
+            /**
+             * Removes the subscriber from the subscriber list.
+             */
+            void removeSubscriber(Subscriber<TYPE> *sub);
+
+            /**
+             * Calls receive() of the given subscriber. Measures the time taken if statistics are enabled.
+             */
+            void receiveItem(Subscriber<TYPE> *sub, const TYPE &item);
+
+            /**
+             * Calls receiveMove() of the given subscriber. Measures the time taken if statistics are enabled.
+             */
+            void receiveItemMove(Subscriber<TYPE> *sub, TYPE &&item);
         };
 
         /**
@@ -70,15 +278,38 @@ namespace VCTR
             // Topic should only give items if this is true.
             bool receiveItems_ = true;
             // Element to topic subscriber list
-            ListLinked<Subscriber<TYPE> *> subListElement_;
+            ListIntrusive_Node<Subscriber<TYPE>> subListElement_;
             // Topic this is subscribed to. Is nullptr if not subscribed.
             Topic<TYPE> *subbedTopic_ = nullptr;
 
+            // True if any filter below is active. Keeps the cost for unfiltered subscribers at a single check.
+            bool filtered_ = false;
+            // Items are only received if this returns true. nullptr disables.
+            bool (*filterFunc_)(const TYPE &item) = nullptr;
+            // Only every decimation_ item is received. 1 receives all.
+            uint16_t decimation_ = 1;
+            // Counts items towards decimation.
+            uint16_t decimationCounter_ = 0;
+            // Min time between received items in ns. 0 disables.
+            int64_t minInterval_ = 0;
+            // Earliest time the next item can be received.
+            int64_t nextReceiveTime_ = 0;
+
+            // Higher priority subscribers receive items first.
+            uint8_t priority_ = 0;
+            // If true, items are received through the topics deferred queue.
+            bool deferred_ = false;
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            // Statistics of this subscriber.
+            SubscriberStats stats_;
+#endif
+
         public:
             Subscriber()
             {
                 receiveItems_ = true;
-                subListElement_[0] = this;
+                subListElement_.setItem(this);
             }
 
             virtual ~Subscriber()
@@ -101,7 +332,52 @@ namespace VCTR
             bool isReceiveEnabled() { return receiveItems_; }
 
             /**
-             * @brief Subscribes to given topic. Unsubscribes to previous subscriber.
+             * @brief Only every n-th published item is received. Rejected items are not copied or passed to receive().
+             * @param n Receive every n-th item. 1 or 0 receives all.
+             */
+            void setDecimation(uint16_t n);
+
+            /**
+             * @brief Limits how often items are received. Items published faster are dropped before being copied or passed to receive().
+             * @param rate_hz Max rate in Hz. 0 disables rate limiting.
+             */
+            void setMaxRate(float rate_hz);
+
+            /**
+             * @brief Items are only received if the given function returns true. Evaluated before decimation and rate limiting.
+             * @param filterFunc Function to check items with. nullptr disables filtering.
+             */
+            void setFilter(bool (*filterFunc)(const TYPE &item));
+
+            /**
+             * @brief Sets the delivery order of this subscriber. Subscribers with higher priority receive items first.
+             * The order is kept sorted on subscribe, so publishing has no extra cost.
+             * @param priority Delivery priority. Higher is earlier. Defaults to 0.
+             * @param deferred If true and the topic has a deferred queue, items are received later from the queue (e.g. a task) instead of during publish.
+             *                 Deferred subscribers always come after all synchronous ones. Use for slow subscribers like loggers.
+             */
+            void setPriority(uint8_t priority, bool deferred = false);
+
+            /**
+             * @returns the delivery priority.
+             */
+            uint8_t getPriority() const { return priority_; }
+
+            /**
+             * @returns true if items are received through the topics deferred queue.
+             */
+            bool isDeferred() const { return deferred_; }
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            /**
+             * @returns the statistics of this subscriber.
+             */
+            const SubscriberStats &getStats() const { return stats_; }
+#endif
+
+            /**
+             * @brief Subscribes to given topic. Unsubscribes from previous topic.
+             * If the topic has a cache, the stored items are received immediately, oldest first.
              * @param topic
              */
             void subscribe(Topic<TYPE> &topic);
@@ -116,6 +392,16 @@ namespace VCTR
             */
             void publish(const TYPE &item);
 
+            /**
+             * @brief Publishes the given item to subscribed topic, but will not receive its item. Item is moved into the last receiver.
+            */
+            void publish(TYPE &&item);
+
+            /**
+             * @brief Publishes the given items to subscribed topic, but will not receive them.
+            */
+            void publishBatch(const TYPE *items, size_t numItems);
+
         protected:
             /**
              * This is called when subscriber is supposed to receive an item.
@@ -123,75 +409,396 @@ namespace VCTR
              * @param topic Which topic is calling this receive function.
              */
             virtual void receive(const TYPE &item, const Topic<TYPE> *topic) = 0;
+
+            /**
+             * Called instead of receive() when this subscriber is the last to receive a moved item. The item can be moved from.
+             * @note Defaults to calling receive(). Implement if the subscriber stores items.
+             * @param item Item that subscriber will receive.
+             * @param topic Which topic is calling this function.
+             */
+            virtual void receiveMove(TYPE &&item, const Topic<TYPE> *topic)
+            {
+                receive(item, topic);
+            }
+
+            /**
+             * Used by Topic::emplace() to construct an item directly inside the subscriber. Counts as having received the item.
+             * @note Defaults to nullptr, meaning not supported. Implement if the subscriber stores items.
+             * @param topic Which topic is calling this function.
+             * @returns pointer to an existing item that will be replaced by the new item or nullptr if not possible.
+             */
+            virtual TYPE *receiveSlot(const Topic<TYPE> *topic)
+            {
+                return nullptr;
+            }
+
+            /**
+             * Called by Topic::publishBatch() with all items at once. Not called for filtered subscribers, they receive items one by one.
+             * @note Defaults to calling receive() for each item. Implement if items can be handled in bulk.
+             * @param items Pointer to items. Oldest first.
+             * @param numItems Number of items.
+             * @param topic Which topic is calling this function.
+             */
+            virtual void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic)
+            {
+                for (size_t i = 0; i < numItems; i++)
+                    receive(items[i], topic);
+            }
+
+        private:
+            /**
+             * @brief Called by topic if this subscriber is filtered. Checks filter, decimation and rate limit.
+             * @returns true if the item should be received.
+             */
+            bool acceptItem(const TYPE &item);
+
+            /**
+             * @brief Updates filtered_ after a filter change.
+             */
+            void updateFiltered();
         };
 
         template <typename TYPE>
         Topic<TYPE>::~Topic()
         {
             unsubscribeAll();
+            setCache(nullptr);
+            setDeferredQueue(nullptr);
         }
 
         template <typename TYPE>
         const List<Subscriber<TYPE> *> &Topic<TYPE>::getSubscriberList() const
         {
-            if (subListStart_ == nullptr)
-            {
-                return ListStatic<Subscriber<TYPE> *, 0>();
-            }
-            return *subListStart_;
+            return subscribers_;
         }
 
         template <typename TYPE>
         void Topic<TYPE>::unsubscribeAll()
         {
-            
-            if (subListStart_ == nullptr)
+
+            while (!subscribers_.isEmpty())
+                subscribers_.getFirst()->getItem()->unsubscribe();
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::setCache(Topic_Cache<TYPE> *cache)
+        {
+            Topic_Cache<TYPE> *previous = cache_;
+            cache_ = cache;
+            if (previous != nullptr && previous != cache)
+                previous->topicDetached();
+        }
+
+        template <typename TYPE>
+        Topic_Cache<TYPE> *Topic<TYPE>::getCache() const
+        {
+            return cache_;
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::setDeferredQueue(Topic_Deferred_Queue<TYPE> *queue)
+        {
+            Topic_Deferred_Queue<TYPE> *previous = deferredQueue_;
+            deferredQueue_ = queue;
+            if (previous != nullptr && previous != queue)
+                previous->topicDetached();
+        }
+
+        template <typename TYPE>
+        Topic_Deferred_Queue<TYPE> *Topic<TYPE>::getDeferredQueue() const
+        {
+            return deferredQueue_;
+        }
+
+        template <typename TYPE>
+        bool Topic<TYPE>::getLatest(TYPE &item) const
+        {
+            if (cache_ == nullptr)
+                return false;
+            return cache_->getLatest(item);
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::publish(const TYPE &item)
+        {
+            publish(item, nullptr);
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::publish(TYPE &&item)
+        {
+            publish(std::move(item), nullptr);
+        }
+
+        template <typename TYPE>
+        template <typename... ARGS>
+        void Topic<TYPE>::emplace(ARGS &&...args)
+        {
+
+            // Find the first subscriber that will receive the item. Its storage is used if possible.
+            ListIntrusive_Node<Subscriber<TYPE>> *next = subscribers_.getFirst();
+            while (next != nullptr && !next->getItem()->receiveItems_)
+                next = subscribers_.getNext(next);
+
+            TYPE *slot = nullptr;
+            if (next != nullptr && !next->getItem()->filtered_ && !isDeferred(next->getItem())) // Filters need the item before it can be placed.
+                slot = next->getItem()->receiveSlot(this);
+
+            if (slot == nullptr)
+            {
+                publish(TYPE(std::forward<ARGS>(args)...));
                 return;
+            }
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishStart();
+            int64_t start = NOW();
+#endif
+
+            slot->~TYPE();
+            new (slot) TYPE(std::forward<ARGS>(args)...);
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.received(next->getItem(), next->getItem()->stats_, NOW() - start);
+#endif
+
+            if (cache_ != nullptr)
+                cache_->place(*slot);
+
+            deliver(subscribers_.getNext(next), *slot, nullptr);
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishEnd();
+#endif
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::publish(const TYPE &item, Subscriber<TYPE> *subscriber)
+        {
+
+            if (cache_ != nullptr)
+                cache_->place(item);
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishStart();
+#endif
+
+            deliver(subscribers_.getFirst(), item, subscriber);
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishEnd();
+#endif
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::publish(TYPE &&item, Subscriber<TYPE> *subscriber)
+        {
+
+            if (cache_ != nullptr)
+                cache_->place(item);
 
-            ListLinked<Subscriber<TYPE> *> *item = subListStart_->getEnd();
-            while (item != nullptr && item != subListStart_)
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishStart();
+#endif
+
+            // Each receiver is only known to be the last once the next receiver is found, so delivery lags one subscriber behind.
+            Subscriber<TYPE> *receiver = nullptr;
+            ListIntrusive_Cursor<Subscriber<TYPE>> cursor(subscribers_);
+            while (ListIntrusive_Node<Subscriber<TYPE>> *node = cursor.next())
             {
+                Subscriber<TYPE> *sub = node->getItem();
+                if (isDeferred(sub)) // All following subscribers are deferred.
+                {
+                    deferredQueue_->place(item);
+                    break;
+                }
 
-                (*item)[0]->unsubscribe();
-                item = item->getPrev();
+                if (isReceiving(sub, item, subscriber))
+                {
+                    if (receiver != nullptr)
+                    {
+                        receiveItem(receiver, item);
+                        if (cursor.getCurrent() == nullptr) // The receiver unsubscribed sub.
+                        {
+                            receiver = nullptr;
+                            continue;
+                        }
+                    }
+                    receiver = sub;
+                }
             }
 
+            if (receiver != nullptr)
+                receiveItemMove(receiver, std::move(item));
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishEnd();
+#endif
         }
 
         template <typename TYPE>
-        void Topic<TYPE>::publish(const TYPE &item)
+        void Topic<TYPE>::publishBatch(const TYPE *items, size_t numItems)
         {
+            publishBatch(items, numItems, nullptr);
+        }
 
-            ListLinked<Subscriber<TYPE> *> *next = subListStart_;
-            if (subListStart_ == nullptr)
+        template <typename TYPE>
+        void Topic<TYPE>::publishBatch(const TYPE *items, size_t numItems, Subscriber<TYPE> *subscriber)
+        {
+
+            if (numItems == 0)
                 return;
 
-            do { // Welcome to this coding tour. Here we can see a very rare do while loop in a place it makes sense.
+            if (cache_ != nullptr)
+            {
+                for (size_t i = 0; i < numItems; i++)
+                    cache_->place(items[i]);
+            }
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishStart(numItems);
+#endif
+
+            // Receivers may unsubscribe any subscriber, the cursor skips them.
+            ListIntrusive_Cursor<Subscriber<TYPE>> cursor(subscribers_);
+            while (ListIntrusive_Node<Subscriber<TYPE>> *node = cursor.next())
+            {
+                Subscriber<TYPE> *sub = node->getItem();
+
+                if (isDeferred(sub)) // All following subscribers are deferred.
+                {
+                    for (size_t i = 0; i < numItems; i++)
+                        deferredQueue_->place(items[i]);
+                    break;
+                }
 
-                if ((*next)[0]->receiveItems_)
+                if (sub->receiveItems_ && sub != subscriber)
                 {
-                    (*next)[0]->receive(item, this);
+                    if (sub->filtered_) // Filters are per item.
+                    {
+                        for (size_t i = 0; i < numItems && cursor.getCurrent() != nullptr; i++)
+                        {
+                            if (sub->acceptItem(items[i]))
+                                receiveItem(sub, items[i]);
+                        }
+                    }
+                    else
+                    {
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+                        int64_t start = NOW();
+                        sub->receiveBatch(items, numItems, this);
+                        stats_.received(sub, sub->stats_, NOW() - start, numItems);
+#else
+                        sub->receiveBatch(items, numItems, this);
+#endif
+                    }
                 }
-                next = next->getNext();
-            } while (next != nullptr && next != subListStart_);
+            }
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            stats_.publishEnd();
+#endif
         }
 
         template <typename TYPE>
-        void Topic<TYPE>::publish(const TYPE &item, Subscriber<TYPE> *subscriber)
+        void Topic<TYPE>::deliver(ListIntrusive_Node<Subscriber<TYPE>> *next, const TYPE &item, Subscriber<TYPE> *subscriber)
         {
 
-            ListLinked<Subscriber<TYPE> *> *next = subListStart_;
-            if (subListStart_ == nullptr)
-                return;
+            // Receivers may unsubscribe any subscriber, the cursor skips them.
+            ListIntrusive_Cursor<Subscriber<TYPE>> cursor(subscribers_, next);
+            while (ListIntrusive_Node<Subscriber<TYPE>> *node = cursor.next())
+            {
+                Subscriber<TYPE> *sub = node->getItem();
 
-            do { // Welcome to this code tour. Here we can see a very rare do while loop in a place it makes sense.
+                if (isDeferred(sub)) // All following subscribers are deferred.
+                {
+                    deferredQueue_->place(item);
+                    return;
+                }
 
-                if ((*next)[0]->receiveItems_ && (*next)[0] != subscriber)
+                if (isReceiving(sub, item, subscriber))
                 {
-                    (*next)[0]->receive(item, this);
+                    receiveItem(sub, item);
                 }
-                next = next->getNext();
-            } while (next != nullptr && next != subListStart_);
+            }
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::publishDeferred(const TYPE &item)
+        {
+
+            ListIntrusive_Node<Subscriber<TYPE>> *next = subscribers_.getFirst();
+            while (next != nullptr && !next->getItem()->deferred_)
+                next = subscribers_.getNext(next);
+
+            ListIntrusive_Cursor<Subscriber<TYPE>> cursor(subscribers_, next);
+            while (ListIntrusive_Node<Subscriber<TYPE>> *node = cursor.next())
+            {
+                Subscriber<TYPE> *sub = node->getItem();
+                if (isReceiving(sub, item, nullptr))
+                    receiveItem(sub, item);
+            }
+        }
+
+        template <typename TYPE>
+        inline bool Topic<TYPE>::isDeferred(Subscriber<TYPE> *sub) const
+        {
+            return sub->deferred_ && deferredQueue_ != nullptr;
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::insertSubscriber(Subscriber<TYPE> *sub)
+        {
+
+            // Find the first subscriber that comes after the new one.
+            ListIntrusive_Node<Subscriber<TYPE>> *next = subscribers_.getFirst();
+            while (next != nullptr)
+            {
+                Subscriber<TYPE> *other = next->getItem();
+                if ((!sub->deferred_ && other->deferred_) || (sub->deferred_ == other->deferred_ && sub->priority_ > other->priority_))
+                    break;
+                next = subscribers_.getNext(next);
+            }
+
+            // nullptr places it at the back.
+            subscribers_.insertBefore(next, sub->subListElement_);
+        }
+
+        template <typename TYPE>
+        void Topic<TYPE>::removeSubscriber(Subscriber<TYPE> *sub)
+        {
+
+            subscribers_.remove(sub->subListElement_);
+        }
+
+        template <typename TYPE>
+        inline bool Topic<TYPE>::isReceiving(Subscriber<TYPE> *sub, const TYPE &item, Subscriber<TYPE> *subscriber)
+        {
+            return sub->receiveItems_ && sub != subscriber && (!sub->filtered_ || sub->acceptItem(item));
+        }
+
+        template <typename TYPE>
+        inline void Topic<TYPE>::receiveItem(Subscriber<TYPE> *sub, const TYPE &item)
+        {
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            int64_t start = NOW();
+            sub->receive(item, this);
+            stats_.received(sub, sub->stats_, NOW() - start);
+#else
+            sub->receive(item, this);
+#endif
+        }
+
+        template <typename TYPE>
+        inline void Topic<TYPE>::receiveItemMove(Subscriber<TYPE> *sub, TYPE &&item)
+        {
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+            int64_t start = NOW();
+            sub->receiveMove(std::move(item), this);
+            stats_.received(sub, sub->stats_, NOW() - start);
+#else
+            sub->receiveMove(std::move(item), this);
+#endif
         }
 
         template <typename TYPE>
@@ -202,52 +809,128 @@ namespace VCTR
         }
 
         template <typename TYPE>
-        void Subscriber<TYPE>::subscribe(Topic<TYPE> &topic)
-        {   
+        void Subscriber<TYPE>::publish(TYPE &&item)
+        {
+            if (subbedTopic_ != nullptr)
+                subbedTopic_->publish(std::move(item), this);
+        }
 
-            subbedTopic_ = &topic;
+        template <typename TYPE>
+        void Subscriber<TYPE>::publishBatch(const TYPE *items, size_t numItems)
+        {
+            if (subbedTopic_ != nullptr)
+                subbedTopic_->publishBatch(items, numItems, this);
+        }
 
-            if (topic.subListStart_ == nullptr)
-            {
-                topic.subListStart_ = &subListElement_;
+        template <typename TYPE>
+        void Subscriber<TYPE>::subscribe(Topic<TYPE> &topic)
+        {
+
+            // Leave if already subscribed to this topic.
+            if (subbedTopic_ == &topic)
                 return;
-            }
 
-            // Check if the subscriber is already in the list. Leave if it is.
-            ListLinked<Subscriber<TYPE> *> *next = topic.subListStart_;
-            while (next != nullptr && next != topic.subListStart_)
+            unsubscribe();
+
+            subbedTopic_ = &topic;
+            topic.insertSubscriber(this);
+
+            // Late joiners receive the stored items so they dont have to wait for the next publish.
+            Topic_Cache<TYPE> *cache = topic.cache_;
+            if (cache != nullptr && receiveItems_)
             {
-                if ((*next)[0] == this)
+                for (size_t i = 0; i < cache->getHistorySize(); i++)
                 {
-                    return;
+                    const TYPE &item = cache->getHistoryItem(i);
+                    if (!filtered_ || acceptItem(item))
+                        receive(item, &topic);
                 }
             }
+        }
 
-            topic.subListStart_->append(subListElement_);
+        template <typename TYPE>
+        void Subscriber<TYPE>::setDecimation(uint16_t n)
+        {
+            decimation_ = n > 1 ? n : 1;
+            decimationCounter_ = 0;
+            updateFiltered();
+        }
 
+        template <typename TYPE>
+        void Subscriber<TYPE>::setMaxRate(float rate_hz)
+        {
+            minInterval_ = rate_hz > 0 ? int64_t(SECONDS / rate_hz) : 0;
+            nextReceiveTime_ = 0;
+            updateFiltered();
         }
 
         template <typename TYPE>
-        void Subscriber<TYPE>::unsubscribe()
+        void Subscriber<TYPE>::setFilter(bool (*filterFunc)(const TYPE &item))
         {
+            filterFunc_ = filterFunc;
+            updateFiltered();
+        }
 
-            if (subbedTopic_ == nullptr) //Already not subscribed.
-                return; 
-            
-            if (subbedTopic_->subListStart_ == &subListElement_) //We are start of list. Set topic list begin to next element. If we are last then this will be nullptr.
+        template <typename TYPE>
+        void Subscriber<TYPE>::setPriority(uint8_t priority, bool deferred)
+        {
+
+            priority_ = priority;
+            deferred_ = deferred;
+
+            // Move to the new position. Does not receive the topics history again.
+            if (subbedTopic_ != nullptr)
             {
-                subbedTopic_->subListStart_ = subListElement_.getNext();
-                subbedTopic_ = nullptr;
-                return;
+                subbedTopic_->removeSubscriber(this);
+                subbedTopic_->insertSubscriber(this);
             }
+        }
 
-            ListLinked<Subscriber<TYPE> *> *next = subbedTopic_->subListStart_;
-            while (next != nullptr && next != subbedTopic_->subListStart_)
+        template <typename TYPE>
+        void Subscriber<TYPE>::updateFiltered()
+        {
+            filtered_ = filterFunc_ != nullptr || decimation_ > 1 || minInterval_ > 0;
+        }
+
+        template <typename TYPE>
+        bool Subscriber<TYPE>::acceptItem(const TYPE &item)
+        {
+
+            if (filterFunc_ != nullptr && !filterFunc_(item))
+                return false;
+
+            if (decimation_ > 1)
+            {
+                if (++decimationCounter_ < decimation_)
+                    return false;
+                decimationCounter_ = 0;
+            }
+
+            if (minInterval_ > 0)
             {
-                if ((*next)[0] == this)
-                    (*next).remove();
+                int64_t time = NOW();
+                if (time < nextReceiveTime_)
+                    return false;
+
+                // Stay in step with the given rate unless we fell behind by more than one interval.
+                if (time - nextReceiveTime_ > minInterval_)
+                    nextReceiveTime_ = time + minInterval_;
+                else
+                    nextReceiveTime_ += minInterval_;
             }
 
+            return true;
+        }
+
+        template <typename TYPE>
+        void Subscriber<TYPE>::unsubscribe()
+        {
+
+            if (subbedTopic_ == nullptr) //Already not subscribed.
+                return; 
+
+            subbedTopic_->removeSubscriber(this);
+
             subbedTopic_ = nullptr;
 
         }
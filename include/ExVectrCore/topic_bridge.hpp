@@ -0,0 +1,426 @@
+#ifndef EXVECTRCORE_TOPICBRIDGE_HPP
+#define EXVECTRCORE_TOPICBRIDGE_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <type_traits>
+
+#include "data_buffer.hpp"
+#include "list_array.hpp"
+#include "task_types.hpp"
+#include "timestamped.hpp"
+#include "topic.hpp"
+#include "topic_handle.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Topic bridge frame format:
+         *
+         * Each frame: channel (uint16_t), data size (uint16_t), timestamp (int64_t), data.
+         * This is the same layout as a data log record, so streams can be dumped directly into a log payload.
+         * All values are in the platforms byte order.
+         */
+
+        /// @brief Size of a frame header in bytes. Frame data follows directly after.
+        constexpr size_t BRIDGE_FRAMEHEADER_SIZE = 12;
+
+        /**
+         * @brief Part of a gathered write. @see Topic_Bridge_Stream::writeSegments()
+         */
+        struct Topic_Bridge_Segment
+        {
+            const void *data;
+            size_t size;
+        };
+
+        /**
+         * @brief Interface class for the byte stream a bridge sends over. e.g. Topic_Bridge_UnixSocket.
+         * All functions must be non-blocking.
+         */
+        class Topic_Bridge_Stream
+        {
+        public:
+            virtual ~Topic_Bridge_Stream() {}
+
+            /**
+             * @brief Called by the bridge on every run. Use to accept or reestablish connections.
+             * @returns true if data can be sent and received.
+             */
+            virtual bool isConnected() = 0;
+
+            /**
+             * @brief Writes the given segments in order as a single write if possible.
+             * @returns number of bytes written. Can be less than given, 0 if the stream can not take any more data right now.
+             */
+            virtual size_t writeSegments(const Topic_Bridge_Segment *segments, size_t numSegments) = 0;
+
+            /**
+             * @brief Reads available data.
+             * @returns number of bytes read. 0 if no data is available.
+             */
+            virtual size_t read(void *data, size_t size) = 0;
+
+            /**
+             * @brief Drops the current connection. Called by the bridge if received data is out of sync,
+             * so both sides start over at a frame boundary. The next isConnected() should reconnect.
+             * @note Defaults to doing nothing. Streams that can reconnect should implement this.
+             */
+            virtual void disconnect() {}
+        };
+
+        /**
+         * @brief Base class for receiving frames of a channel from a bridge.
+         * @see Topic_Bridge_Receiver
+         */
+        class Topic_Bridge_Channel
+        {
+            friend class Topic_Bridge;
+
+        private:
+            /// @brief Channel this receives.
+            uint16_t channel_ = 0;
+
+        public:
+            virtual ~Topic_Bridge_Channel() {}
+
+            /**
+             * @returns the channel this receives.
+             */
+            uint16_t getChannel() const { return channel_; }
+
+        protected:
+            Topic_Bridge_Channel(uint16_t channel) : channel_(channel) {}
+
+            /**
+             * @brief Called by bridge for each received frame in this channel.
+             */
+            virtual void receiveFrame(int64_t timestamp, const uint8_t *data, uint16_t size) = 0;
+        };
+
+        /**
+         * @brief Connects topics to another process through a byte stream.
+         * Publishing only copies the frame into a send ring. The bridge task writes everything in the ring with a single
+         * gathered write per run, so many small items are coalesced into few large writes.
+         * If the ring is full, frames are dropped and counted instead of blocking the publisher. @see getDroppedFrames(), getFill()
+         * Received frames are given to the Topic_Bridge_Channel of the same channel.
+         * @note Add the bridge to the same scheduler as the publishing tasks.
+         */
+        class Topic_Bridge : public Task_Periodic
+        {
+        private:
+            /// @brief Stream to send and receive with.
+            Topic_Bridge_Stream *stream_ = nullptr;
+
+            /// @brief Ring of outgoing bytes.
+            uint8_t *sendBuffer_ = nullptr;
+            /// @brief Size of the send ring.
+            size_t sendSize_ = 0;
+            /// @brief Index of the next outgoing byte.
+            size_t sendTail_ = 0;
+            /// @brief Number of bytes waiting to be sent.
+            size_t sendUsed_ = 0;
+            /// @brief Index of the first frame not completely sent.
+            size_t sendFrameStart_ = 0;
+            /// @brief Number of bytes of that frame already sent. The rest is dropped on a disconnect.
+            size_t sendFrameSent_ = 0;
+            /// @brief Most bytes waiting at once.
+            size_t sendUsedMax_ = 0;
+
+            /// @brief Incoming bytes of incomplete frames.
+            uint8_t *receiveBuffer_ = nullptr;
+            /// @brief Size of the receive buffer. Is also the max frame size.
+            size_t receiveSize_ = 0;
+            /// @brief Number of bytes in receive buffer.
+            size_t receiveUsed_ = 0;
+
+            /// @brief Channels to give received frames to.
+            ListArray<Topic_Bridge_Channel *> channels_;
+
+            /// @brief Number of frames placed into the send ring.
+            size_t sentFrames_ = 0;
+            /// @brief Number of frames dropped due to a full send ring or no connection.
+            size_t droppedFrames_ = 0;
+            /// @brief Number of bytes written to the stream.
+            size_t bytesWritten_ = 0;
+            /// @brief Number of received frames.
+            size_t receivedFrames_ = 0;
+            /// @brief Number of times received data was not a valid frame. Each disconnects the stream.
+            size_t receiveErrors_ = 0;
+            /// @brief If frames should be dropped while not connected.
+            bool dropUnconnected_ = true;
+            /// @brief Connection state of the last run.
+            bool connected_ = false;
+
+        public:
+            /**
+             * @param stream Stream to send and receive with.
+             * @param sendSize Size of the send ring in bytes.
+             * @param receiveSize Size of the receive buffer in bytes. Limits the size of received frames.
+             * @param interval_ns Interval at which the bridge sends and receives.
+             */
+            Topic_Bridge(Topic_Bridge_Stream &stream, size_t sendSize = 4096, size_t receiveSize = 512, int64_t interval_ns = 1 * MILLISECONDS);
+
+            ~Topic_Bridge();
+
+            Topic_Bridge(const Topic_Bridge &) = delete;
+            Topic_Bridge &operator=(const Topic_Bridge &) = delete;
+
+            /**
+             * @brief Places a frame into the send ring. Never blocks.
+             * @param frame Complete frame. Header followed by data.
+             * @param size Size of the frame in bytes.
+             * @returns false if dropped due to a full ring or no connection.
+             */
+            bool sendFrame(const uint8_t *frame, size_t size);
+
+            /**
+             * @brief Places a frame built from the given data into the send ring. Data is copied directly into the ring. Never blocks.
+             * @param channel Channel of frame.
+             * @param timestamp Timestamp of frame.
+             * @param data Frame data.
+             * @param size Size of data in bytes.
+             * @returns false if dropped due to a full ring or no connection.
+             */
+            bool sendFrame(uint16_t channel, int64_t timestamp, const void *data, uint16_t size);
+
+            /**
+             * @brief Adds a channel to give received frames to.
+             */
+            void addChannel(Topic_Bridge_Channel &channel);
+
+            /**
+             * @brief Removes the given channel.
+             */
+            void removeChannel(Topic_Bridge_Channel &channel);
+
+            /**
+             * @brief Sets if frames are dropped while the stream is not connected. Otherwise they are kept until the ring is full.
+             * @param drop Defaults to true.
+             */
+            void setDropUnconnected(bool drop);
+
+            /**
+             * @returns true if the stream was connected on the last run.
+             */
+            bool isConnected() const;
+
+            /**
+             * @returns how full the send ring is from 0 to 1. Use as backpressure signal to reduce publishing.
+             */
+            float getFill() const;
+
+            /**
+             * @returns the most bytes waiting in the send ring at once.
+             */
+            size_t getFillMax() const;
+
+            /**
+             * @returns number of frames placed into the send ring.
+             */
+            size_t getSentFrames() const;
+
+            /**
+             * @returns number of frames dropped due to a full send ring or no connection.
+             */
+            size_t getDroppedFrames() const;
+
+            /**
+             * @returns number of bytes written to the stream.
+             */
+            size_t getBytesWritten() const;
+
+            /**
+             * @returns number of received frames.
+             */
+            size_t getReceivedFrames() const;
+
+            /**
+             * @returns number of times received data was not a valid frame. The stream is disconnected each time to get back in sync.
+             */
+            size_t getReceiveErrors() const;
+
+            /**
+             * @brief Writes as much of the send ring as the stream takes.
+             */
+            void flush();
+
+            void taskThread() override;
+
+        private:
+            /**
+             * @brief Reads from the stream and gives complete frames to channels.
+             */
+            void receive();
+
+            /**
+             * @returns true if a frame of given size can be placed into the send ring. Counts dropped frames.
+             */
+            bool canSend(size_t size);
+
+            /**
+             * @brief Copies data into the send ring. Space must have been checked.
+             */
+            void writeRing(const void *data, size_t size);
+
+            /**
+             * @brief Moves the start of the first unsent frame past all frames completed by the given number of written bytes.
+             */
+            void advanceSentFrames(size_t written);
+
+            /**
+             * @returns size of the frame starting at given index of the send ring, including its header.
+             */
+            size_t getFrameSize(size_t position) const;
+        };
+
+        /**
+         * @brief Sends the items of a timestamped topic over a bridge.
+         * @tparam TYPE Data type of topic. Must be trivially copyable as it is sent as raw bytes.
+         */
+        template <typename TYPE>
+        class Topic_Bridge_Sender : public Subscriber<Timestamped<TYPE>>
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Topic_Bridge_Sender requires a trivially copyable type.");
+            static_assert(sizeof(TYPE) <= UINT16_MAX, "Type too large to be sent.");
+
+        private:
+            Topic_Bridge *bridge_ = nullptr;
+            uint16_t channel_ = 0;
+
+        public:
+            /**
+             * @param bridge Bridge to send over.
+             * @param channel Channel to send items under.
+             */
+            Topic_Bridge_Sender(Topic_Bridge &bridge, uint16_t channel) : bridge_(&bridge), channel_(channel) {}
+
+            /**
+             * @param bridge Bridge to send over.
+             * @param channel Channel to send items under.
+             * @param topic Topic to send.
+             */
+            Topic_Bridge_Sender(Topic_Bridge &bridge, uint16_t channel, Topic<Timestamped<TYPE>> &topic) : bridge_(&bridge), channel_(channel)
+            {
+                this->subscribe(topic);
+            }
+
+        private:
+            void receive(const Timestamped<TYPE> &item, const Topic<Timestamped<TYPE>> *topic) override
+            {
+                DataBuffer<BRIDGE_FRAMEHEADER_SIZE + sizeof(TYPE)> frame;
+                frame.write(channel_);
+                frame.write(uint16_t(sizeof(TYPE)));
+                frame.write(item.timestamp);
+                frame.write(item.data);
+
+                bridge_->sendFrame(frame.getData(), frame.getPtr());
+            }
+        };
+
+        /**
+         * @brief Sends the items of a topic of any type over a bridge. Frames are timestamped with the time of sending.
+         * Trivially copyable items are copied directly into the send ring, other types are serialized. @see Topic_Serializer
+         * @tparam MAXSIZE Max size of serialized items in bytes. Only used for types that are not trivially copyable.
+         */
+        template <size_t MAXSIZE = 256>
+        class Topic_Bridge_Raw_Sender : public Topic_Raw_Subscriber
+        {
+        private:
+            Topic_Bridge *bridge_ = nullptr;
+            uint16_t channel_ = 0;
+
+        public:
+            /**
+             * @param bridge Bridge to send over.
+             * @param channel Channel to send items under.
+             */
+            Topic_Bridge_Raw_Sender(Topic_Bridge &bridge, uint16_t channel) : bridge_(&bridge), channel_(channel) {}
+
+            /**
+             * @param bridge Bridge to send over.
+             * @param channel Channel to send items under.
+             * @param topic Topic to send.
+             */
+            Topic_Bridge_Raw_Sender(Topic_Bridge &bridge, uint16_t channel, const Topic_Handle &topic) : bridge_(&bridge), channel_(channel)
+            {
+                this->subscribe(topic);
+            }
+
+        protected:
+            void receiveRaw(const void *item, const Topic_Handle &topic) override
+            {
+                if (topic.isTrivial())
+                {
+                    if (topic.getItemSize() <= UINT16_MAX)
+                        bridge_->sendFrame(channel_, NOW(), item, uint16_t(topic.getItemSize()));
+                    return;
+                }
+
+                uint8_t buffer[MAXSIZE];
+                size_t size = topic.serialize(item, buffer, MAXSIZE);
+                if (size > 0 && size <= UINT16_MAX)
+                    bridge_->sendFrame(channel_, NOW(), buffer, uint16_t(size));
+            }
+        };
+
+        /**
+         * @brief Publishes frames of a channel received by a bridge into a timestamped topic.
+         * @tparam TYPE Data type of topic. Must be the type the channel was sent with.
+         */
+        template <typename TYPE>
+        class Topic_Bridge_Receiver : public Topic_Bridge_Channel
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Topic_Bridge_Receiver requires a trivially copyable type.");
+
+        private:
+            Topic_Bridge *bridge_ = nullptr;
+            Topic<Timestamped<TYPE>> *topic_ = nullptr;
+            size_t sizeMismatches_ = 0;
+
+        public:
+            /**
+             * @param bridge Bridge to receive from.
+             * @param channel Channel to receive.
+             * @param topic Topic to publish items to.
+             */
+            Topic_Bridge_Receiver(Topic_Bridge &bridge, uint16_t channel, Topic<Timestamped<TYPE>> &topic) : Topic_Bridge_Channel(channel), bridge_(&bridge), topic_(&topic)
+            {
+                bridge.addChannel(*this);
+            }
+
+            ~Topic_Bridge_Receiver()
+            {
+                bridge_->removeChannel(*this);
+            }
+
+            /**
+             * @returns number of frames skipped due to their size not matching TYPE.
+             */
+            size_t getSizeMismatches() const { return sizeMismatches_; }
+
+        protected:
+            void receiveFrame(int64_t timestamp, const uint8_t *data, uint16_t size) override
+            {
+                if (size != sizeof(TYPE))
+                {
+                    sizeMismatches_++;
+                    return;
+                }
+
+                Timestamped<TYPE> item(timestamp);
+                memcpy(&item.data, data, sizeof(TYPE));
+                topic_->publish(item);
+            }
+        };
+
+    }
+
+}
+
+#endif
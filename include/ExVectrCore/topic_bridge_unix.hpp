@@ -0,0 +1,79 @@
+#ifndef EXVECTRCORE_TOPICBRIDGEUNIX_HPP
+#define EXVECTRCORE_TOPICBRIDGEUNIX_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include "topic_bridge.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Bridge stream over a UNIX domain socket. Can either listen for a connection or connect to a listening socket.
+         * All socket operations are non-blocking. Lost connections are reestablished by isConnected(), called on every bridge run.
+         * Data is written as a gathered write (sendmsg(), writev() with flags), so the bridge ring goes out in a single system call.
+         * @note Only for POSIX platforms.
+         */
+        class Topic_Bridge_UnixSocket : public Topic_Bridge_Stream
+        {
+        private:
+            /// @brief Path of the socket.
+            char path_[108];
+            /// @brief True if listening for connections, false if connecting.
+            bool listen_ = false;
+            /// @brief Listening socket. -1 if none.
+            int listenFd_ = -1;
+            /// @brief Connected socket. -1 if not connected.
+            int fd_ = -1;
+
+        public:
+            Topic_Bridge_UnixSocket();
+
+            /**
+             * @param path Path of the socket.
+             * @param listen If true, the socket file is created and the other process connects. Otherwise connects to an existing socket.
+             */
+            Topic_Bridge_UnixSocket(const char *path, bool listen);
+
+            ~Topic_Bridge_UnixSocket();
+
+            Topic_Bridge_UnixSocket(const Topic_Bridge_UnixSocket &) = delete;
+            Topic_Bridge_UnixSocket &operator=(const Topic_Bridge_UnixSocket &) = delete;
+
+            /**
+             * @brief Sets the socket to use. Closes any previous socket. Connecting happens on the next isConnected().
+             * @param path Path of the socket.
+             * @param listen If true, the socket file is created and the other process connects. Otherwise connects to an existing socket.
+             */
+            void open(const char *path, bool listen);
+
+            /**
+             * @brief Closes the socket.
+             */
+            void close();
+
+            bool isConnected() override;
+
+            size_t writeSegments(const Topic_Bridge_Segment *segments, size_t numSegments) override;
+
+            size_t read(void *data, size_t size) override;
+
+            /**
+             * @brief Closes only the connection. A listening socket stays open.
+             */
+            void disconnect() override;
+        };
+
+    }
+
+}
+
+#endif
+
+#endif
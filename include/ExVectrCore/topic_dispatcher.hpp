@@ -0,0 +1,206 @@
+#ifndef EXVECTRCORE_TOPICDISPATCHER_HPP
+#define EXVECTRCORE_TOPICDISPATCHER_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include "list_buffer.hpp"
+#include "scheduler2.hpp"
+#include "time_definitions.hpp"
+
+#include "topic.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Queues items for the deferred subscribers of a topic and gives them the items from a scheduler task.
+         * This keeps slow subscribers (loggers, telemetry) out of the publishing path of latency critical subscribers.
+         * If the queue is full the oldest item is dropped, so publishing never blocks.
+         * e.g.
+         *      Topic<Imu> imuTopic;
+         *      Topic_Deferred_Dispatcher<Imu, 32> imuDispatcher(imuTopic);
+         *      logger.setPriority(0, true);
+         *      controller.setPriority(255);
+         *
+         * @note Not thread safe. The task must run on the same thread that publishes to the topic.
+         * @tparam TYPE Data type of topic.
+         * @tparam SIZE Max number of queued items.
+         */
+        template <typename TYPE, size_t SIZE>
+        class Topic_Deferred_Dispatcher : public Scheduler::Task, public Topic_Deferred_Queue<TYPE>
+        {
+        private:
+            /**
+             * A queued item together with its publish time.
+             */
+            struct Deferred_Item
+            {
+                TYPE item;
+                int64_t time;
+            };
+
+            /// @brief Queued items. Newest at front.
+            ListBuffer<Deferred_Item, SIZE> items_;
+            /// @brief Topic this dispatches for.
+            Topic<TYPE> *topic_ = nullptr;
+            /// @brief Max number of items given out per run. 0 gives out all.
+            size_t maxItemsPerRun_ = 0;
+            /// @brief Items older than this are dropped instead of given out. 0 disables.
+            int64_t maxAge_ = 0;
+            /// @brief Number of items dropped due to a full queue.
+            size_t droppedItems_ = 0;
+            /// @brief Number of items dropped for being older than maxAge_.
+            size_t expiredItems_ = 0;
+
+        public:
+            /**
+             * @param maxItemsPerRun Max number of items given out per run. 0 gives out all.
+             */
+            Topic_Deferred_Dispatcher(size_t maxItemsPerRun = 0)
+            {
+                maxItemsPerRun_ = maxItemsPerRun;
+
+                strncpy(taskName_, "Topic_Deferred_Dispatcher", 50);
+                taskName_[49] = '\0';
+
+                setPaused(true);
+            }
+
+            /**
+             * @param topic Topic to dispatch for.
+             * @param maxItemsPerRun Max number of items given out per run. 0 gives out all.
+             */
+            Topic_Deferred_Dispatcher(Topic<TYPE> &topic, size_t maxItemsPerRun = 0) : Topic_Deferred_Dispatcher(maxItemsPerRun)
+            {
+                attach(topic);
+            }
+
+            ~Topic_Deferred_Dispatcher()
+            {
+                detach();
+            }
+
+            /**
+             * @brief Starts dispatching for given topic. Detaches from previous topic.
+             */
+            void attach(Topic<TYPE> &topic)
+            {
+                detach();
+                topic_ = &topic;
+                topic.setDeferredQueue(this);
+            }
+
+            /**
+             * @brief Stops dispatching. Queued items are dropped and deferred subscribers receive items during publish again.
+             */
+            void detach()
+            {
+                Topic<TYPE> *topic = topic_;
+                topic_ = nullptr;
+                if (topic != nullptr && topic->getDeferredQueue() == this)
+                    topic->setDeferredQueue(nullptr);
+                items_.clear();
+                setPaused(true);
+            }
+
+            void topicDetached() override
+            {
+                // Queued items were for the old topic.
+                topic_ = nullptr;
+                detach();
+            }
+
+            /**
+             * @brief Items older than the given age when dispatched are dropped. Use to keep deferred subscribers from working on stale data.
+             * @param maxAge_ns Max age in ns. 0 disables.
+             */
+            void setMaxAge(int64_t maxAge_ns)
+            {
+                maxAge_ = maxAge_ns;
+            }
+
+            /**
+             * @returns number of queued items.
+             */
+            size_t getQueuedItems() const
+            {
+                return items_.size();
+            }
+
+            /**
+             * @returns number of items dropped due to a full queue.
+             */
+            size_t getDroppedItems() const
+            {
+                return droppedItems_;
+            }
+
+            /**
+             * @returns number of items dropped for being older than the max age.
+             */
+            size_t getExpiredItems() const
+            {
+                return expiredItems_;
+            }
+
+            void place(const TYPE &item) override
+            {
+
+                if (items_.size() == items_.sizeMax())
+                    droppedItems_++;
+
+                Deferred_Item *slot = items_.placeFrontSlot(true);
+                slot->item = item;
+                slot->time = NOW();
+
+                setPaused(false);
+            }
+
+            void taskCheck() override
+            {
+
+                if (items_.size() == 0)
+                {
+                    setPaused(true);
+                    return;
+                }
+
+                // The oldest item sets the release so waiting items raise the tasks priority.
+                setRelease(items_[items_.size() - 1].time);
+            }
+
+            void taskThread() override
+            {
+
+                int64_t now = NOW();
+                size_t dispatched = 0;
+
+                Deferred_Item deferredItem;
+                while ((maxItemsPerRun_ == 0 || dispatched < maxItemsPerRun_) && items_.takeBack(deferredItem))
+                {
+                    if (maxAge_ > 0 && now - deferredItem.time > maxAge_)
+                    {
+                        expiredItems_++;
+                        continue;
+                    }
+
+                    if (topic_ != nullptr)
+                        topic_->publishDeferred(deferredItem.item);
+                    dispatched++;
+                }
+
+                if (items_.size() == 0)
+                    setPaused(true);
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef EXVECTRCORE_TOPICHANDLE_HPP
+#define EXVECTRCORE_TOPICHANDLE_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include <type_traits>
+#include <utility>
+
+#include "type_id.hpp"
+#include "topic.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Type erased topics. A Topic_Handle refers to a Topic<TYPE> of any type, so generic tools (recorders, monitors, bridges)
+         * can be written once and used with any topic.
+         *
+         * e.g.
+         *      Topic_Handle handle(imuTopic);
+         *      handle.getItemSize();
+         *      handle.publishRaw(bytes, size);
+         *      rawRecorder.subscribe(handle);
+         */
+
+        /**
+         * @brief Converts items to and from bytes for type erased topics.
+         * Trivially copyable types are handled as their raw bytes. Specialize this for other types to make them serializable.
+         * e.g.
+         *      template <>
+         *      struct Topic_Serializer<MyType> { static size_t serialize(...); static bool deserialize(...); };
+         *
+         * @tparam TYPE Type to serialize.
+         */
+        template <typename TYPE, bool TRIVIAL = std::is_trivially_copyable<TYPE>::value>
+        struct Topic_Serializer
+        {
+            /**
+             * @brief Writes item into buffer.
+             * @returns number of bytes written. 0 if the buffer is too small or the type is not serializable.
+             */
+            static size_t serialize(const TYPE &item, uint8_t *buffer, size_t size) { return 0; }
+
+            /**
+             * @brief Reads item from buffer.
+             * @returns false if the buffer does not contain a valid item or the type is not serializable.
+             */
+            static bool deserialize(const uint8_t *buffer, size_t size, TYPE &item) { return false; }
+        };
+
+        template <typename TYPE>
+        struct Topic_Serializer<TYPE, true>
+        {
+            static size_t serialize(const TYPE &item, uint8_t *buffer, size_t size)
+            {
+                if (size < sizeof(TYPE))
+                    return 0;
+                memcpy(buffer, &item, sizeof(TYPE));
+                return sizeof(TYPE);
+            }
+
+            static bool deserialize(const uint8_t *buffer, size_t size, TYPE &item)
+            {
+                if (size != sizeof(TYPE))
+                    return false;
+                memcpy(&item, buffer, sizeof(TYPE));
+                return true;
+            }
+        };
+
+        class Topic_Raw_Subscriber;
+
+        /**
+         * @brief Base class of the typed subscribers connecting a Topic_Raw_Subscriber to a topic.
+         */
+        class Topic_Raw_Adapter
+        {
+        public:
+            virtual ~Topic_Raw_Adapter() {}
+        };
+
+        /**
+         * @brief Functions for a single topic type. One static instance exists per type. @see getTopicHandleOps()
+         */
+        struct Topic_Handle_Ops
+        {
+            /// @brief Id of the topics item type.
+            TypeId typeId;
+            /// @brief Size of the topics item type in bytes.
+            size_t itemSize;
+            /// @brief True if the serialized form of an item are its raw bytes.
+            bool trivial;
+            /// @brief Writes item into buffer. Returns number of bytes written, 0 on failure.
+            size_t (*serialize)(const void *item, uint8_t *buffer, size_t size);
+            /// @brief Reads item from buffer. Returns false on failure.
+            bool (*deserialize)(const uint8_t *buffer, size_t size, void *item);
+            /// @brief Publishes a serialized item on topic. Returns false if data is not a valid item.
+            bool (*publishRaw)(void *topic, const void *data, size_t size);
+            /// @brief Creates a subscriber to topic that passes items to the raw subscriber.
+            Topic_Raw_Adapter *(*createAdapter)(void *topic, Topic_Raw_Subscriber &subscriber);
+        };
+
+        /**
+         * @brief Reference to a topic of any type.
+         * Cheap to copy, as it only contains the topic pointer and a pointer to the static functions of its type.
+         */
+        class Topic_Handle
+        {
+        private:
+            void *topic_ = nullptr;
+            const Topic_Handle_Ops *ops_ = nullptr;
+
+        public:
+            /**
+             * @brief Creates an invalid handle.
+             */
+            Topic_Handle() {}
+
+            /**
+             * @param topic Topic to refer to.
+             */
+            template <typename TYPE>
+            Topic_Handle(Topic<TYPE> &topic);
+
+            /**
+             * @param topic Pointer to a Topic<TYPE>.
+             * @param ops Functions of TYPE. @see getTopicHandleOps()
+             */
+            Topic_Handle(void *topic, const Topic_Handle_Ops *ops) : topic_(topic), ops_(ops) {}
+
+            /**
+             * @returns true if this refers to a topic.
+             */
+            bool isValid() const { return topic_ != nullptr && ops_ != nullptr; }
+
+            /**
+             * @returns pointer to the Topic<TYPE>.
+             */
+            void *getTopic() const { return topic_; }
+
+            /**
+             * @returns the functions of the topics type.
+             */
+            const Topic_Handle_Ops *getOps() const { return ops_; }
+
+            /**
+             * @returns id of the topics item type. nullptr if invalid.
+             */
+            TypeId getTypeId() const { return ops_ != nullptr ? ops_->typeId : nullptr; }
+
+            /**
+             * @returns size of the topics item type in bytes. 0 if invalid.
+             */
+            size_t getItemSize() const { return ops_ != nullptr ? ops_->itemSize : 0; }
+
+            /**
+             * @returns true if the serialized form of an item are its raw bytes. Allows using items directly without serializing.
+             */
+            bool isTrivial() const { return ops_ != nullptr && ops_->trivial; }
+
+            /**
+             * @returns true if the topic has the given item type.
+             */
+            template <typename TYPE>
+            bool isType() const { return getTypeId() == Core::getTypeId<TYPE>(); }
+
+            /**
+             * @returns the typed topic or nullptr if the topic has a different item type.
+             */
+            template <typename TYPE>
+            Topic<TYPE> *get() const { return isType<TYPE>() ? static_cast<Topic<TYPE> *>(topic_) : nullptr; }
+
+            /**
+             * @brief Writes an item of this topic into buffer.
+             * @param item Pointer to an item of the topics type. e.g. as given to Topic_Raw_Subscriber::receiveRaw().
+             * @returns number of bytes written. 0 if buffer is too small or the type is not serializable.
+             */
+            size_t serialize(const void *item, uint8_t *buffer, size_t size) const
+            {
+                return ops_ != nullptr ? ops_->serialize(item, buffer, size) : 0;
+            }
+
+            /**
+             * @brief Reads an item of this topic from buffer.
+             * @param item Pointer to an item of the topics type to read into.
+             * @returns false if buffer does not contain a valid item.
+             */
+            bool deserialize(const uint8_t *buffer, size_t size, void *item) const
+            {
+                return ops_ != nullptr && ops_->deserialize(buffer, size, item);
+            }
+
+            /**
+             * @brief Publishes a serialized item on the topic.
+             * Trivially copyable items in suitably aligned memory are published directly from the given memory without an intermediate copy.
+             * @returns false if data is not a valid item.
+             */
+            bool publishRaw(const void *data, size_t size) const
+            {
+                return isValid() && ops_->publishRaw(topic_, data, size);
+            }
+
+            bool operator==(const Topic_Handle &other) const { return topic_ == other.topic_ && ops_ == other.ops_; }
+
+            bool operator!=(const Topic_Handle &other) const { return !(*this == other); }
+        };
+
+        /**
+         * @brief Receives items from a topic of any type. Subscribe with a Topic_Handle.
+         * Items are given as pointer to the typed item, so no copy or serialization happens unless the subscriber needs it.
+         */
+        class Topic_Raw_Subscriber
+        {
+            template <typename TYPE>
+            friend class Topic_Raw_Adapter_Typed;
+
+        private:
+            /// @brief Typed subscriber connecting this to the topic. Owned by this.
+            Topic_Raw_Adapter *adapter_ = nullptr;
+            /// @brief Topic subscribed to.
+            Topic_Handle topic_;
+
+        public:
+            Topic_Raw_Subscriber() {}
+
+            virtual ~Topic_Raw_Subscriber()
+            {
+                unsubscribe();
+            }
+
+            Topic_Raw_Subscriber(const Topic_Raw_Subscriber &) = delete;
+            Topic_Raw_Subscriber &operator=(const Topic_Raw_Subscriber &) = delete;
+
+            /**
+             * @brief Subscribes to the given topic. Unsubscribes from previous topic.
+             */
+            void subscribe(const Topic_Handle &topic)
+            {
+                unsubscribe();
+
+                if (!topic.isValid())
+                    return;
+
+                topic_ = topic;
+                adapter_ = topic.getOps()->createAdapter(topic.getTopic(), *this);
+            }
+
+            /**
+             * @brief Unsubscribes. Will not receive any more published items.
+             */
+            void unsubscribe()
+            {
+                delete adapter_;
+                adapter_ = nullptr;
+                topic_ = Topic_Handle();
+            }
+
+            /**
+             * @returns handle of the subscribed topic. Invalid if not subscribed.
+             */
+            const Topic_Handle &getTopicHandle() const { return topic_; }
+
+        protected:
+            /**
+             * This is called when subscriber is supposed to receive an item.
+             * @param item Pointer to the item. Its type is the item type of topic. @see Topic_Handle::serialize()
+             * @param topic Which topic is calling this receive function.
+             */
+            virtual void receiveRaw(const void *item, const Topic_Handle &topic) = 0;
+        };
+
+        /**
+         * @brief Subscriber to a Topic<TYPE> passing items to a Topic_Raw_Subscriber.
+         */
+        template <typename TYPE>
+        class Topic_Raw_Adapter_Typed : public Subscriber<TYPE>, public Topic_Raw_Adapter
+        {
+        private:
+            Topic_Raw_Subscriber *subscriber_;
+
+        public:
+            Topic_Raw_Adapter_Typed(Topic<TYPE> &topic, Topic_Raw_Subscriber &subscriber) : subscriber_(&subscriber)
+            {
+                this->subscribe(topic);
+            }
+
+        private:
+            void receive(const TYPE &item, const Topic<TYPE> *topic) override
+            {
+                subscriber_->receiveRaw(&item, subscriber_->topic_);
+            }
+        };
+
+        /**
+         * @brief Type erased functions of a topic type.
+         */
+        template <typename TYPE>
+        struct Topic_Handle_Functions
+        {
+            static size_t serialize(const void *item, uint8_t *buffer, size_t size)
+            {
+                return Topic_Serializer<TYPE>::serialize(*static_cast<const TYPE *>(item), buffer, size);
+            }
+
+            static bool deserialize(const uint8_t *buffer, size_t size, void *item)
+            {
+                return Topic_Serializer<TYPE>::deserialize(buffer, size, *static_cast<TYPE *>(item));
+            }
+
+            static bool publishRaw(void *topic, const void *data, size_t size)
+            {
+                Topic<TYPE> *typedTopic = static_cast<Topic<TYPE> *>(topic);
+
+                // Raw bytes of a trivially copyable type in aligned memory are already a valid item.
+                if (std::is_trivially_copyable<TYPE>::value && size == sizeof(TYPE) && uintptr_t(data) % alignof(TYPE) == 0)
+                {
+                    typedTopic->publish(*static_cast<const TYPE *>(data));
+                    return true;
+                }
+
+                TYPE item;
+                if (!Topic_Serializer<TYPE>::deserialize(static_cast<const uint8_t *>(data), size, item))
+                    return false;
+
+                typedTopic->publish(std::move(item));
+                return true;
+            }
+
+            static Topic_Raw_Adapter *createAdapter(void *topic, Topic_Raw_Subscriber &subscriber)
+            {
+                return new Topic_Raw_Adapter_Typed<TYPE>(*static_cast<Topic<TYPE> *>(topic), subscriber);
+            }
+        };
+
+        /**
+         * @returns the type erased functions of given topic type.
+         */
+        template <typename TYPE>
+        const Topic_Handle_Ops *getTopicHandleOps()
+        {
+            static const Topic_Handle_Ops ops = {
+                getTypeId<TYPE>(),
+                sizeof(TYPE),
+                std::is_trivially_copyable<TYPE>::value,
+                &Topic_Handle_Functions<TYPE>::serialize,
+                &Topic_Handle_Functions<TYPE>::deserialize,
+                &Topic_Handle_Functions<TYPE>::publishRaw,
+                &Topic_Handle_Functions<TYPE>::createAdapter};
+
+            return &ops;
+        }
+
+        template <typename TYPE>
+        Topic_Handle::Topic_Handle(Topic<TYPE> &topic) : topic_(&topic), ops_(getTopicHandleOps<TYPE>()) {}
+
+    }
+
+}
+
+#endif
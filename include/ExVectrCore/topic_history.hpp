@@ -0,0 +1,150 @@
+#ifndef EXVECTRCORE_TOPICHISTORY_HPP
+#define EXVECTRCORE_TOPICHISTORY_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <atomic>
+
+#include "topic.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Keeps the last DEPTH items published to a topic.
+         * New subscribers receive the stored items on subscribe(), which is useful for slow topics like configuration or calibration.
+         * The latest item can be polled by any thread with getLatest() without locking. (Seqlock)
+         * @note getLatest() copies TYPE while it might be written. Only use it from other threads for trivially copyable types.
+         * e.g.
+         *      Topic<Config> configTopic;
+         *      Topic_History<Config, 1> configHistory(configTopic);
+         *
+         * @tparam TYPE Data type of topic.
+         * @tparam DEPTH Number of items to keep.
+         */
+        template <typename TYPE, size_t DEPTH>
+        class Topic_History : public Topic_Cache<TYPE>
+        {
+            static_assert(DEPTH > 0, "Topic_History needs a depth of at least 1.");
+
+        private:
+            /// @brief Ring of the stored items.
+            TYPE items_[DEPTH];
+            /// @brief Index of the slot the next item is placed into.
+            size_t next_ = 0;
+            /// @brief Number of stored items.
+            size_t numItems_ = 0;
+            /// @brief Sequence counter. Is odd while an item is being written.
+            std::atomic<uint32_t> sequence_;
+            /// @brief Topic this is attached to.
+            Topic<TYPE> *topic_ = nullptr;
+
+        public:
+            Topic_History() : sequence_(0) {}
+
+            /**
+             * @param topic Topic to keep history of.
+             */
+            Topic_History(Topic<TYPE> &topic) : sequence_(0)
+            {
+                attach(topic);
+            }
+
+            ~Topic_History()
+            {
+                detach();
+            }
+
+            /**
+             * @brief Starts keeping the history of given topic. Detaches from previous topic.
+             */
+            void attach(Topic<TYPE> &topic)
+            {
+                detach();
+                topic_ = &topic;
+                topic.setCache(this);
+            }
+
+            /**
+             * @brief Stops keeping history. Stored items are kept.
+             */
+            void detach()
+            {
+                Topic<TYPE> *topic = topic_;
+                topic_ = nullptr;
+                if (topic != nullptr && topic->getCache() == this)
+                    topic->setCache(nullptr);
+            }
+
+            void topicDetached() override
+            {
+                topic_ = nullptr;
+            }
+
+            /**
+             * @brief Removes all stored items.
+             */
+            void clear()
+            {
+                sequence_.fetch_add(1, std::memory_order_acq_rel);
+                numItems_ = 0;
+                next_ = 0;
+                sequence_.fetch_add(1, std::memory_order_release);
+            }
+
+            void place(const TYPE &item) override
+            {
+                sequence_.fetch_add(1, std::memory_order_acq_rel); // Odd, readers will retry.
+
+                items_[next_] = item;
+                next_ = (next_ + 1) % DEPTH;
+                if (numItems_ < DEPTH)
+                    numItems_++;
+
+                sequence_.fetch_add(1, std::memory_order_release); // Even again, item is consistent.
+            }
+
+            bool getLatest(TYPE &item) const override
+            {
+                uint32_t sequenceStart;
+                uint32_t sequenceEnd;
+                bool hasItem;
+
+                do
+                {
+                    sequenceStart = sequence_.load(std::memory_order_acquire);
+                    if (sequenceStart & 1) // Writer is busy.
+                        continue;
+
+                    hasItem = numItems_ > 0;
+                    if (hasItem)
+                        item = items_[(next_ + DEPTH - 1) % DEPTH];
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    sequenceEnd = sequence_.load(std::memory_order_relaxed);
+
+                } while ((sequenceStart & 1) || sequenceStart != sequenceEnd);
+
+                return hasItem;
+            }
+
+            size_t getHistorySize() const override
+            {
+                return numItems_;
+            }
+
+            const TYPE &getHistoryItem(size_t index) const override
+            {
+                return items_[(next_ + DEPTH - numItems_ + index) % DEPTH];
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef EXVECTRCORE_TOPICREGISTRY_HPP
+#define EXVECTRCORE_TOPICREGISTRY_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include "type_id.hpp"
+#include "topic.hpp"
+#include "topic_handle.hpp"
+#include "print.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Global topic system. Topics are found by the hash of their name and created on first use, so modules can connect
+         * to each other without passing references around and without caring about setup order.
+         *
+         * e.g. Topic<Timestamped<float>> &temperature = getNamedTopic<Timestamped<float>, topicNameHash("sensors/temperature")>();
+         *
+         * The name is hashed at compile time and the topic is cached after the first lookup, so using a named topic costs
+         * the same as using a normal topic reference.
+         *
+         * Two names can have the same 32 bit hash. Passing the check hash of the name as well keeps them apart:
+         *      getNamedTopic<Timestamped<float>, topicNameHash("sensors/temperature"), topicNameCheck("sensors/temperature")>();
+         * The functions taking the name as string always do this. A check of 0 matches any topic with the same hash.
+         */
+
+        /**
+         * @brief Computes the 32 bit FNV-1a hash of the given name. Evaluated at compile time when used as a template parameter.
+         * @param name Null terminated name of topic.
+         * @param hash Used for recursion. Leave default.
+         * @returns hash of name.
+         */
+        constexpr uint32_t topicNameHash(const char *name, uint32_t hash = 2166136261u)
+        {
+            return *name == '\0' ? hash : topicNameHash(name + 1, (hash ^ uint32_t(uint8_t(*name))) * 16777619u);
+        }
+
+        /**
+         * @brief Computes a second hash of the given name, independent of topicNameHash(), to tell apart names with the same hash.
+         * Uses djb2. Never 0, as 0 means no check.
+         * @param name Null terminated name of topic.
+         * @param hash Used for recursion. Leave default.
+         * @returns check hash of name.
+         */
+        constexpr uint32_t topicNameCheck(const char *name, uint32_t hash = 5381u)
+        {
+            return *name == '\0' ? (hash == 0 ? 1 : hash) : topicNameCheck(name + 1, (hash * 33u) ^ uint32_t(uint8_t(*name)));
+        }
+
+        /**
+         * @brief Maps name hashes to topics and their types. Hash table with O(1) lookup.
+         * @note Not to be used directly. @see getNamedTopic()
+         */
+        class TopicRegistry
+        {
+        private:
+            struct Entry
+            {
+                /// @brief Hash of topic name.
+                uint32_t nameHash = 0;
+                /// @brief Check hash of topic name. 0 if unknown.
+                uint32_t nameCheck = 0;
+                /// @brief Functions of the topics type. nullptr if entry is empty.
+                const Topic_Handle_Ops *ops = nullptr;
+                /// @brief Pointer to the Topic<TYPE>.
+                void *topic = nullptr;
+            };
+
+            /// @brief Hash table using open addressing. Size is always a power of two.
+            Entry *table_ = nullptr;
+            /// @brief Number of entries in table.
+            size_t capacity_ = 0;
+            /// @brief Number of registered topics.
+            size_t numTopics_ = 0;
+
+        public:
+            TopicRegistry();
+
+            ~TopicRegistry();
+
+            /**
+             * @brief Finds the topic with the given name.
+             * @param nameHash Hash of the topic name.
+             * @param type Is set to the type of the found topic.
+             * @param nameCheck Check hash of the topic name. 0 matches any topic with the same hash.
+             * @returns pointer to topic or nullptr if not found.
+             */
+            void *find(uint32_t nameHash, TypeId &type, uint32_t nameCheck = 0) const;
+
+            /**
+             * @brief Finds the topic with the given name.
+             * @param nameHash Hash of the topic name.
+             * @param nameCheck Check hash of the topic name. 0 matches any topic with the same hash.
+             * @returns handle to the topic. Invalid if not found.
+             */
+            Topic_Handle findHandle(uint32_t nameHash, uint32_t nameCheck = 0) const;
+
+            /**
+             * @brief Adds a topic with the given name.
+             * @param nameHash Hash of the topic name.
+             * @param ops Functions of the topics type. @see getTopicHandleOps()
+             * @param topic Pointer to the topic.
+             * @param nameCheck Check hash of the topic name. 0 if unknown.
+             * @returns false if a topic with given name already exists.
+             */
+            bool add(uint32_t nameHash, const Topic_Handle_Ops *ops, void *topic, uint32_t nameCheck = 0);
+
+            /**
+             * @returns number of registered topics.
+             */
+            size_t size() const;
+
+        private:
+            /**
+             * @returns index of entry with given hash and check or of the empty entry where it would be placed.
+             */
+            size_t findIndex(uint32_t nameHash, uint32_t nameCheck) const;
+
+            /**
+             * @brief Doubles the table size and rehashes all entries.
+             */
+            void grow();
+        };
+
+        /**
+         * @returns the global topic registry.
+         */
+        TopicRegistry &getTopicRegistry();
+
+        /**
+         * @brief Registers an existing topic under the given name. Allows modules owning a topic to make it available by name.
+         * @param nameHash Hash of topic name. @see topicNameHash()
+         * @param topic Topic to register. Must stay valid for the rest of the program.
+         * @param nameCheck Check hash of topic name. @see topicNameCheck()
+         * @returns false if a topic with the given name already exists.
+         */
+        template <typename TYPE>
+        bool registerNamedTopic(uint32_t nameHash, Topic<TYPE> &topic, uint32_t nameCheck = 0)
+        {
+            return getTopicRegistry().add(nameHash, getTopicHandleOps<TYPE>(), &topic, nameCheck);
+        }
+
+        /**
+         * @brief Registers an existing topic under the given name. @see registerNamedTopic()
+         * @param name Null terminated name of topic.
+         */
+        template <typename TYPE>
+        bool registerNamedTopic(const char *name, Topic<TYPE> &topic)
+        {
+            return registerNamedTopic(topicNameHash(name), topic, topicNameCheck(name));
+        }
+
+        /**
+         * @brief Finds the topic with the given name. Creates the topic if it does not exist yet.
+         * @note Does a hash table lookup. Use getNamedTopic<TYPE, HASH>() for cached access.
+         * @param nameHash Hash of topic name. @see topicNameHash()
+         * @param nameCheck Check hash of topic name. @see topicNameCheck()
+         * @returns pointer to topic or nullptr if the name is used by a topic of a different type.
+         */
+        template <typename TYPE>
+        Topic<TYPE> *findNamedTopic(uint32_t nameHash, uint32_t nameCheck = 0)
+        {
+            TopicRegistry &registry = getTopicRegistry();
+
+            TypeId type;
+            void *topic = registry.find(nameHash, type, nameCheck);
+
+            if (topic == nullptr)
+            {
+                Topic<TYPE> *newTopic = new Topic<TYPE>(); // Lives for the rest of the program.
+                registry.add(nameHash, getTopicHandleOps<TYPE>(), newTopic, nameCheck);
+                return newTopic;
+            }
+
+            if (type != getTypeId<TYPE>())
+                return nullptr;
+
+            return static_cast<Topic<TYPE> *>(topic);
+        }
+
+        /**
+         * @brief Finds the topic with the given name. Creates the topic if it does not exist yet. @see findNamedTopic()
+         * @param name Null terminated name of topic.
+         */
+        template <typename TYPE>
+        Topic<TYPE> *findNamedTopic(const char *name)
+        {
+            return findNamedTopic<TYPE>(topicNameHash(name), topicNameCheck(name));
+        }
+
+        /**
+         * @brief Finds the topic with the given name without knowing its type. Does not create topics.
+         * Use for generic tools like recorders or bridges. @see Topic_Handle
+         * @param nameHash Hash of topic name. @see topicNameHash()
+         * @param nameCheck Check hash of topic name. @see topicNameCheck()
+         * @returns handle to the topic. Invalid if not found.
+         */
+        inline Topic_Handle findNamedTopicHandle(uint32_t nameHash, uint32_t nameCheck = 0)
+        {
+            return getTopicRegistry().findHandle(nameHash, nameCheck);
+        }
+
+        /**
+         * @brief Finds the topic with the given name without knowing its type. @see findNamedTopicHandle()
+         * @param name Null terminated name of topic.
+         */
+        inline Topic_Handle findNamedTopicHandle(const char *name)
+        {
+            return findNamedTopicHandle(topicNameHash(name), topicNameCheck(name));
+        }
+
+        /**
+         * @brief Gets the topic with the given name. Creates the topic on first use.
+         * Only the first call does a lookup, after that the cached topic is returned.
+         * @note If the name is already used by a topic of a different type an error is printed and a seperate unnamed topic is returned.
+         * @tparam TYPE Data type of the topic.
+         * @tparam NAMEHASH Hash of topic name. e.g. topicNameHash("imu/raw")
+         * @tparam NAMECHECK Check hash of topic name. e.g. topicNameCheck("imu/raw"). 0 matches any topic with the same hash.
+         * @returns reference to topic.
+         */
+        template <typename TYPE, uint32_t NAMEHASH, uint32_t NAMECHECK = 0>
+        Topic<TYPE> &getNamedTopic()
+        {
+            static Topic<TYPE> *topic = nullptr;
+
+            if (topic == nullptr)
+            {
+                topic = findNamedTopic<TYPE>(NAMEHASH, NAMECHECK);
+
+                if (topic == nullptr)
+                {
+                    printE("Topic with name hash %u already exists with a different type.\n", unsigned(NAMEHASH));
+                    static Topic<TYPE> unnamedTopic;
+                    topic = &unnamedTopic;
+                }
+            }
+
+            return *topic;
+        }
+
+    }
+
+}
+
+#endif
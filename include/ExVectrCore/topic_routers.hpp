@@ -2,8 +2,9 @@
 #define EXVECTRCORE_TOPICROUTERS_H
 
 #include "stddef.h"
+#include "stdint.h"
 
-#include "list_array.hpp"
+#include "list_small.hpp"
 
 #include "topic.hpp"
 #include "topic_subscribers.hpp"
@@ -19,50 +20,299 @@ namespace VCTR
          */
 
         /**
-         * This router simply transfers data from one topic to all other topics.
+         * Number of routers the item currently being forwarded has passed through. Shared by all routers of a type,
+         * whatever their batch size, so loops through different router types are counted too.
+         * @tparam TYPE Data type of routed topics.
          */
         template <typename TYPE>
-        class TopicRouter : public Subscriber_Interface<TYPE>
+        struct Router_Hops
+        {
+            static uint8_t hops;
+        };
+
+        template <typename TYPE>
+        uint8_t Router_Hops<TYPE>::hops = 0;
+
+        /**
+         * This router transfers data published on one of its topics to all its other topics.
+         *
+         * Loops between routers (e.g. two routers both connecting topic A and B) are prevented in two ways:
+         * - Origin: While a router forwards an item it will not accept items, so an item looping back to it is dropped.
+         * - Hop count: Items are dropped after passing through maxHops routers in a row.
+         *
+         * @tparam TYPE Data type of topics.
+         * @tparam BATCH If larger than 0, items are collected per topic and forwarded BATCH at a time or on flush() using Topic::publishBatch().
+         *               This trades latency for less dispatch overhead on busy topics. Defaults to 0 which forwards immediately.
+         */
+        template <typename TYPE, size_t BATCH = 0>
+        class TopicRouter
         {
         private:
-            ListArray<Topic<TYPE> *> topicsList_;
+            /// @brief Size of port batch storage. 1 if not batching.
+            static constexpr size_t PENDING_SIZE = BATCH > 0 ? BATCH : 1;
+
+            /**
+             * Subscriber connecting the router to one of its topics.
+             */
+            class Router_Port : public Subscriber<TYPE>
+            {
+                friend TopicRouter;
+
+            private:
+                TopicRouter *router_;
+                Topic<TYPE> *topic_;
+                // Items waiting to be forwarded, oldest first. Only used if BATCH > 0.
+                TYPE pendingItems_[PENDING_SIZE];
+                // Number of routers each waiting item had passed through.
+                uint8_t pendingHops_[PENDING_SIZE];
+                // Number of waiting items.
+                size_t numPending_ = 0;
+
+            public:
+                Router_Port(TopicRouter &router, Topic<TYPE> &topic) : router_(&router), topic_(&topic)
+                {
+                    this->subscribe(topic);
+                }
+
+            private:
+                void receive(const TYPE &item, const Topic<TYPE> *topic) override
+                {
+                    router_->receiveFromPort(*this, &item, 1);
+                }
+
+                void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic) override
+                {
+                    router_->receiveFromPort(*this, items, numItems);
+                }
+            };
+
+            /// @brief Ports of all connected topics.
+            ListSmall<Router_Port *, 4> ports_;
+            /// @brief Items are dropped after passing through this many routers in a row.
+            uint8_t maxHops_ = 8;
+            /// @brief True while this router is forwarding. Items arriving now have looped back.
+            bool forwarding_ = false;
+            /// @brief Number of forwarded items.
+            size_t forwardedItems_ = 0;
+            /// @brief Number of items dropped due to loops or hop limit.
+            size_t droppedItems_ = 0;
+
+            /**
+             * @returns the number of routers the current item has passed through.
+             */
+            static uint8_t &getHopCount()
+            {
+                return Router_Hops<TYPE>::hops;
+            }
 
         public:
             TopicRouter() {}
 
+            ~TopicRouter();
+
             /**
-             * @returns True if new data was received
+             * @brief Adds the given topic to the router. Items from all other topics will be forwarded to it and its items to all others.
+             * @param topicToForward Topic to add.
              */
             void addTopicToForward(Topic<TYPE> &topicToForward);
 
+            /**
+             * @brief Removes the given topic from the router.
+             * @param topicToRemove Topic to remove.
+             * @returns true if found and removed.
+             */
+            bool removeTopicToForward(Topic<TYPE> &topicToRemove);
+
+            /**
+             * @brief Sets the max number of routers an item can pass through in a row.
+             */
+            void setMaxHops(uint8_t maxHops);
+
+            /**
+             * @brief Forwards all items waiting in batches. Does nothing if BATCH is 0.
+             * @note Call this periodically (e.g. from a task) to limit latency when batching.
+             */
+            void flush();
+
+            /**
+             * @returns number of items forwarded.
+             */
+            size_t getForwardedItems() const;
+
+            /**
+             * @returns number of items dropped due to loops or hop limit.
+             */
+            size_t getDroppedItems() const;
+
         private:
             /**
-             * Will recieve a message from topic and forward it to all other topics in list.
-             * @param item Item to forward to other topic.
-             * @param topic Which toic called this receive() function that will not get item forwarded to.
+             * Called by a port on receiving items. Forwards them or places them into the ports batch.
+             * @param port Port the items were received from.
+             * @param items Items to forward to other topics. Oldest first.
+             * @param numItems Number of items.
              */
-            void receive(TYPE &item, const Topic<TYPE> *topic) override;
+            void receiveFromPort(Router_Port &port, const TYPE *items, size_t numItems);
+
+            /**
+             * Forwards items to all topics except the one of the given port.
+             */
+            void forward(Router_Port &port, const TYPE *items, size_t numItems);
+
+            /**
+             * Forwards all items of given port to all other topics.
+             */
+            void flushPort(Router_Port &port);
         };
 
-        template <typename TYPE>
-        void TopicRouter<TYPE>::addTopicToForward(Topic<TYPE> &topicToForward)
+        template <typename TYPE, size_t BATCH>
+        constexpr size_t TopicRouter<TYPE, BATCH>::PENDING_SIZE;
+
+        template <typename TYPE, size_t BATCH>
+        TopicRouter<TYPE, BATCH>::~TopicRouter()
         {
-            topicsList_.appendIfNotInList(&topicToForward);
+            for (size_t i = 0; i < ports_.size(); i++)
+                delete ports_[i];
         }
 
-        template <typename TYPE>
-        void TopicRouter<TYPE>::receive(TYPE &item, const Topic<TYPE> *topic)
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::addTopicToForward(Topic<TYPE> &topicToForward)
+        {
+            for (size_t i = 0; i < ports_.size(); i++)
+            {
+                if (ports_[i]->topic_ == &topicToForward)
+                    return;
+            }
+
+            ports_.append(new Router_Port(*this, topicToForward));
+        }
+
+        template <typename TYPE, size_t BATCH>
+        bool TopicRouter<TYPE, BATCH>::removeTopicToForward(Topic<TYPE> &topicToRemove)
         {
-            for (size_t i = 0; i < topicsList_.size(); i++)
+            for (size_t i = 0; i < ports_.size(); i++)
             {
-                Topic<TYPE> *topicForward = topicsList_[i];
-                if (topicForward != &topic)
-                    topicForward->publish(item, this);
+                Router_Port *port = ports_[i];
+                if (port->topic_ == &topicToRemove)
+                {
+                    flushPort(*port);
+                    ports_.removeAtIndex(i);
+                    delete port;
+                    return true;
+                }
             }
+
+            return false;
+        }
+
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::setMaxHops(uint8_t maxHops)
+        {
+            maxHops_ = maxHops;
+        }
+
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::flush()
+        {
+            if (BATCH == 0)
+                return;
+
+            for (size_t i = 0; i < ports_.size(); i++)
+                flushPort(*ports_[i]);
+        }
+
+        template <typename TYPE, size_t BATCH>
+        size_t TopicRouter<TYPE, BATCH>::getForwardedItems() const
+        {
+            return forwardedItems_;
+        }
+
+        template <typename TYPE, size_t BATCH>
+        size_t TopicRouter<TYPE, BATCH>::getDroppedItems() const
+        {
+            return droppedItems_;
+        }
+
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::receiveFromPort(Router_Port &port, const TYPE *items, size_t numItems)
+        {
+
+            if (forwarding_ || getHopCount() >= maxHops_) // Items have looped back or travelled too far.
+            {
+                droppedItems_ += numItems;
+                return;
+            }
+
+            if (BATCH == 0)
+            {
+                getHopCount()++;
+                forward(port, items, numItems);
+                getHopCount()--;
+                return;
+            }
+
+            for (size_t i = 0; i < numItems; i++)
+            {
+                port.pendingItems_[port.numPending_] = items[i];
+                port.pendingHops_[port.numPending_] = getHopCount();
+                port.numPending_++;
+                if (port.numPending_ == BATCH)
+                    flushPort(port);
+            }
+        }
+
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::forward(Router_Port &port, const TYPE *items, size_t numItems)
+        {
+
+            forwarding_ = true;
+
+            for (size_t i = 0; i < ports_.size(); i++)
+            {
+                if (ports_[i] == &port)
+                    continue;
+
+                // Publishes to all subscribers except the port itself.
+                if (numItems == 1)
+                    ports_[i]->publish(items[0]);
+                else
+                    ports_[i]->publishBatch(items, numItems);
+            }
+
+            forwarding_ = false;
+            forwardedItems_ += numItems;
+        }
+
+        template <typename TYPE, size_t BATCH>
+        void TopicRouter<TYPE, BATCH>::flushPort(Router_Port &port)
+        {
+
+            size_t numItems = port.numPending_;
+            if (BATCH == 0 || numItems == 0)
+                return;
+
+            port.numPending_ = 0;
+            uint8_t hops = getHopCount();
+
+            // Items keep their hop count so loops through batching routers still end.
+            // Runs of items with the same count, usually the whole batch, are forwarded with a single publishBatch().
+            size_t start = 0;
+            while (start < numItems)
+            {
+                size_t end = start + 1;
+                while (end < numItems && port.pendingHops_[end] == port.pendingHops_[start])
+                    end++;
+
+                getHopCount() = port.pendingHops_[start] + 1;
+                forward(port, port.pendingItems_ + start, end - start);
+
+                start = end;
+            }
+
+            getHopCount() = hops;
         }
 
     }
 
 }
 
-#endif
\ No newline at end of file
+#endif
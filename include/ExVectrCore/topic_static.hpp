@@ -0,0 +1,154 @@
+#ifndef EXVECTRCORE_TOPICSTATIC_HPP
+#define EXVECTRCORE_TOPICSTATIC_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <utility>
+
+#include "topic.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Topic whose subscribers are fixed at compile time. For pipelines where the wiring never changes.
+         * The receive functions are template parameters, so publish() calls them directly in the given order without any virtual calls or list traversal
+         * and the compiler can inline them.
+         * Runtime subscribers can still subscribe to getTopic(). They receive items after all static receivers.
+         * Static topics can be chained at compile time by giving dispatch() of one static topic as receive function of another.
+         * e.g.
+         *      void controllerReceive(const Imu &imu);
+         *      void estimatorReceive(const Imu &imu);
+         *
+         *      StaticTopic<Imu, controllerReceive, estimatorReceive> imuTopic;
+         *      Simple_Subscriber<Imu> display(imuTopic.getTopic());
+         *      imuTopic.publish(imu);
+         *
+         * @tparam TYPE Data type of topic.
+         * @tparam FUNCS Functions receiving published items. Called in given order.
+         */
+        template <typename TYPE, void (*... FUNCS)(const TYPE &)>
+        class StaticTopic
+        {
+        private:
+            /**
+             * Subscriber that publishes items from a dynamic topic to this topic.
+             */
+            class Static_Input : public Subscriber<TYPE>
+            {
+            private:
+                StaticTopic *staticTopic_;
+
+            public:
+                Static_Input(StaticTopic &staticTopic) : staticTopic_(&staticTopic) {}
+
+            private:
+                void receive(const TYPE &item, const Topic<TYPE> *topic) override
+                {
+                    staticTopic_->publish(item);
+                }
+
+                void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic) override
+                {
+                    staticTopic_->publishBatch(items, numItems);
+                }
+            };
+
+            /// @brief Topic for runtime subscribers.
+            Topic<TYPE> topic_;
+            /// @brief Receives from a dynamic source topic if connected.
+            Static_Input input_;
+
+        public:
+            StaticTopic() : input_(*this) {}
+
+            StaticTopic(const StaticTopic &) = delete;
+            StaticTopic &operator=(const StaticTopic &) = delete;
+
+            /**
+             * @brief Gives item to static receivers, then to runtime subscribers.
+             * @param item Item to be sent.
+             */
+            inline void publish(const TYPE &item)
+            {
+                dispatch(item);
+                topic_.publish(item);
+            }
+
+            /**
+             * @brief Gives item to static receivers, then moves it into the runtime subscribers.
+             * @param item Item to be sent.
+             */
+            inline void publish(TYPE &&item)
+            {
+                dispatch(item);
+                topic_.publish(std::move(item));
+            }
+
+            /**
+             * @brief Gives items to static receivers one by one, then to runtime subscribers as a batch.
+             * @param items Pointer to items to be sent. Oldest first.
+             * @param numItems Number of items.
+             */
+            inline void publishBatch(const TYPE *items, size_t numItems)
+            {
+                for (size_t i = 0; i < numItems; i++)
+                    dispatch(items[i]);
+                topic_.publishBatch(items, numItems);
+            }
+
+            /**
+             * @brief Gives item to the static receivers only.
+             * Usable as receive function of another static topic to build a static graph.
+             * @param item Item to be sent.
+             */
+            static inline void dispatch(const TYPE &item)
+            {
+                // Pack expansion inside a braced list is evaluated in order.
+                int expand[] = {0, (FUNCS(item), 0)...};
+                (void)expand;
+            }
+
+            /**
+             * @returns the dynamic topic used by runtime subscribers.
+             */
+            Topic<TYPE> &getTopic()
+            {
+                return topic_;
+            }
+
+            /**
+             * @brief Publishes all items of the given dynamic topic on this topic. Replaces the previous source.
+             * @param source Topic to receive items from.
+             */
+            void connectSource(Topic<TYPE> &source)
+            {
+                input_.subscribe(source);
+            }
+
+            /**
+             * @brief Stops receiving from the source topic.
+             */
+            void disconnectSource()
+            {
+                input_.unsubscribe();
+            }
+
+            /**
+             * @returns the number of static receivers.
+             */
+            static constexpr size_t getNumStaticReceivers()
+            {
+                return sizeof...(FUNCS);
+            }
+        };
+
+    }
+
+}
+
+#endif
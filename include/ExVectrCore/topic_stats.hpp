@@ -0,0 +1,161 @@
+#ifndef EXVECTRCORE_TOPICSTATS_HPP
+#define EXVECTRCORE_TOPICSTATS_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * Topic statistics are only collected if EXVECTR_TOPIC_STATS_ENABLE is defined (see topic.hpp).
+         * If not defined, none of the counters below exist inside topics or subscribers and there is no runtime cost.
+         * @see TopicStats_Task for publishing periodic snapshots.
+         */
+
+        /**
+         * @brief Statistics of a single subscriber.
+         */
+        struct SubscriberStats
+        {
+            /// @brief Number of received items.
+            uint64_t receiveCount = 0;
+            /// @brief Total time spent inside receive() in ns.
+            int64_t receiveTime = 0;
+            /// @brief Longest time spent inside a single receive() in ns.
+            int64_t maxReceiveTime = 0;
+        };
+
+        /**
+         * @brief Snapshot of a topics statistics. Published by TopicStats_Task.
+         */
+        struct TopicStats_Snapshot
+        {
+            /// @brief Address of the topic. Identifies the topic.
+            const void *topic = nullptr;
+            /// @brief Size of the topics item type in bytes.
+            size_t itemSize = 0;
+            /// @brief Total number of publishes.
+            uint64_t publishCount = 0;
+            /// @brief Total number of bytes published. (publishCount * itemSize)
+            uint64_t publishBytes = 0;
+            /// @brief Publishes per second since the previous snapshot.
+            float publishRate = 0;
+            /// @brief Number of subscribers that received the last publish.
+            uint16_t fanout = 0;
+            /// @brief Max number of subscribers that received a single publish.
+            uint16_t maxFanout = 0;
+            /// @brief Total time spent in all receive() calls in ns.
+            int64_t receiveTime = 0;
+            /// @brief Address of the subscriber with the longest single receive() call.
+            const void *slowestSubscriber = nullptr;
+            /// @brief Longest single receive() call in ns.
+            int64_t maxReceiveTime = 0;
+        };
+
+        /**
+         * @brief Statistics of a single topic. All instances are kept in a global list so they can be iterated.
+         */
+        class TopicStats
+        {
+        private:
+            /// @brief Global list of all topic statistics.
+            TopicStats *next_ = nullptr;
+            TopicStats *prev_ = nullptr;
+
+            /// @brief Collected statistics. Publish rate is calculated on snapshot.
+            TopicStats_Snapshot stats_;
+            /// @brief Number of receivers of the publish in progress.
+            uint16_t currentFanout_ = 0;
+            /// @brief Publish count of the previous snapshot.
+            uint64_t lastPublishCount_ = 0;
+            /// @brief Time of previous snapshot.
+            int64_t lastSnapshotTime_ = 0;
+
+        public:
+            /**
+             * @param topic Address of topic.
+             * @param itemSize Size of the topics item type.
+             */
+            TopicStats(const void *topic, size_t itemSize);
+
+            ~TopicStats();
+
+            TopicStats(const TopicStats &) = delete;
+            TopicStats &operator=(const TopicStats &) = delete;
+
+            /**
+             * @returns the first statistics in the global list. nullptr if there are no topics.
+             */
+            static TopicStats *getFirst();
+
+            /**
+             * @returns the next statistics in the global list. nullptr if at end.
+             */
+            TopicStats *getNext() const;
+
+            /**
+             * @brief Creates a snapshot of the statistics and calculates the publish rate since the previous snapshot.
+             * @param time Current time in ns.
+             */
+            TopicStats_Snapshot snapshot(int64_t time);
+
+            /**
+             * @returns the collected statistics. Publish rate is from the last snapshot.
+             */
+            const TopicStats_Snapshot &getStats() const;
+
+            /**
+             * @brief Called by topic at the start of a publish.
+             * @param numItems Number of items published.
+             */
+            inline void publishStart(size_t numItems = 1)
+            {
+                stats_.publishCount += numItems;
+                stats_.publishBytes += numItems * stats_.itemSize;
+                currentFanout_ = 0;
+            }
+
+            /**
+             * @brief Called by topic after each receive().
+             * @param subscriber Address of the subscriber.
+             * @param subscriberStats Statistics of the subscriber.
+             * @param time Time spent in receive() in ns.
+             * @param numItems Number of items received.
+             */
+            inline void received(const void *subscriber, SubscriberStats &subscriberStats, int64_t time, size_t numItems = 1)
+            {
+                currentFanout_++;
+
+                subscriberStats.receiveCount += numItems;
+                subscriberStats.receiveTime += time;
+                if (time > subscriberStats.maxReceiveTime)
+                    subscriberStats.maxReceiveTime = time;
+
+                stats_.receiveTime += time;
+                if (time > stats_.maxReceiveTime)
+                {
+                    stats_.maxReceiveTime = time;
+                    stats_.slowestSubscriber = subscriber;
+                }
+            }
+
+            /**
+             * @brief Called by topic at the end of a publish.
+             */
+            inline void publishEnd()
+            {
+                stats_.fanout = currentFanout_;
+                if (currentFanout_ > stats_.maxFanout)
+                    stats_.maxFanout = currentFanout_;
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef EXVECTRCORE_TOPICSTATSTASK_HPP
+#define EXVECTRCORE_TOPICSTATSTASK_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include "topic.hpp"
+#include "topic_stats.hpp"
+#include "task_types.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Topic on which TopicStats_Task publishes the statistics snapshots of all topics.
+         */
+        Topic<TopicStats_Snapshot> &getTopicStatsTopic();
+
+        /**
+         * @brief Periodically publishes a snapshot of every topics statistics to getTopicStatsTopic().
+         * @note Does nothing if EXVECTR_TOPIC_STATS_ENABLE is not defined.
+         */
+        class TopicStats_Task : public Task_Periodic
+        {
+        public:
+            /**
+             * @param interval_ns Interval between snapshots in nanoseconds.
+             */
+            TopicStats_Task(int64_t interval_ns = 1 * SECONDS);
+
+            void taskThread() override;
+        };
+
+    }
+
+}
+
+#endif
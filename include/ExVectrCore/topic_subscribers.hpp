@@ -4,9 +4,12 @@
 #include "topic.hpp"
 #include "list_buffer.hpp"
 #include "list_array.hpp"
+#include "spsc_buffer.hpp"
 
 #include "stddef.h"
 
+#include <utility>
+
 namespace VCTR
 {
 
@@ -18,6 +21,7 @@ namespace VCTR
          *
          * Simple_Subscriber is fastest and only contains one item.
          * Buffer_Subscriber is identical to FiFoBuffer but auto adds items to beginning of buffer.
+         * SPSC_Buffer_Subscriber is a Buffer_Subscriber that can be read from another thread than the publisher.
          */
 
         /**
@@ -39,13 +43,33 @@ namespace VCTR
                 itemIsNew = true;
             }
 
+            void receiveMove(TYPE &&item, const Topic<TYPE> *topic) override
+            {
+                receivedItem = std::move(item);
+                itemIsNew = true;
+            }
+
+            void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic) override
+            {
+                if (numItems == 0)
+                    return;
+                receivedItem = items[numItems - 1];
+                itemIsNew = true;
+            }
+
+            TYPE *receiveSlot(const Topic<TYPE> *topic) override
+            {
+                itemIsNew = true;
+                return &receivedItem;
+            }
+
         public:
             Simple_Subscriber() {}
 
             /**
              * @param topic Topic to subscribe to.
              */
-            Simple_Subscriber(Topic<TYPE> &topic) { subscribe(topic); }
+            Simple_Subscriber(Topic<TYPE> &topic) { this->subscribe(topic); }
 
             /**
              * @returns True if new data was received
@@ -80,19 +104,20 @@ namespace VCTR
             /**
              * @param topic Topic to subscribe to.
              */
-            Topic_Publisher(Topic<TYPE> &topic) { subscribe(topic); }
+            Topic_Publisher(Topic<TYPE> &topic) { this->subscribe(topic); }
         };
 
         /**
          * This subscriber implements a Fifo. New items are placed into Fifo front.
          * @see Simple_Subscriber for receiving only one item.
          *
+         * @tparam FEATURES ListBuffer_Feature flags of the buffer.
          */
-        template <typename TYPE, size_t SIZE>
-        class Buffer_Subscriber : public Subscriber<TYPE>, public ListBuffer<TYPE, SIZE>
+        template <typename TYPE, size_t SIZE, uint8_t FEATURES = LISTBUFFER_PLAIN>
+        class Buffer_Subscriber : public Subscriber<TYPE>, public ListBuffer<TYPE, SIZE, FEATURES>
         {
         public:
-            Buffer_Subscriber(bool overwrite = false) {}
+            Buffer_Subscriber(bool overwrite = false) { overwrite_ = overwrite; }
 
             /**
              * @param topic Topic to subscribe to.
@@ -100,8 +125,8 @@ namespace VCTR
              */
             Buffer_Subscriber(Topic<TYPE> &topic, bool overwrite = false)
             {
-                subscribe(topic);
                 overwrite_ = overwrite;
+                this->subscribe(topic);
             }
 
             /**
@@ -116,9 +141,78 @@ namespace VCTR
                 this->placeFront(item, overwrite_);
             }
 
+            void receiveMove(TYPE &&item, const Topic<TYPE> *topic) override
+            {
+                this->placeFront(std::move(item), overwrite_);
+            }
+
+            TYPE *receiveSlot(const Topic<TYPE> *topic) override
+            {
+                // Items written in place would bypass the ListBuffer features, so they are received as a copy instead.
+                if (FEATURES != LISTBUFFER_PLAIN)
+                    return nullptr;
+                return this->placeFrontSlot(overwrite_);
+            }
+
+            void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic) override
+            {
+                this->placeFrontN(items, numItems, overwrite_);
+            }
+
             bool overwrite_ = false;
         };
 
+        /**
+         * This subscriber implements a wait free Fifo for when the publisher and reader run on different threads (e.g. ISR and main loop).
+         * Items are placed into the front by the publishing thread, the reading thread takes them from the back.
+         * Unlike Buffer_Subscriber it can not overwrite, new items are dropped if full.
+         * @note Subscribing and unsubscribing are not thread safe, do that before the publishing thread starts.
+         * @see SPSC_Buffer
+         *
+         * @tparam SIZE Number of items. Must be a power of two.
+         */
+        template <typename TYPE, size_t SIZE>
+        class SPSC_Buffer_Subscriber : public Subscriber<TYPE>, public SPSC_Buffer<TYPE, SIZE>
+        {
+        public:
+            SPSC_Buffer_Subscriber() : droppedItems_(0) {}
+
+            /**
+             * @param topic Topic to subscribe to.
+             */
+            SPSC_Buffer_Subscriber(Topic<TYPE> &topic) : droppedItems_(0)
+            {
+                this->subscribe(topic);
+            }
+
+            /**
+             * @returns number of items dropped because the buffer was full.
+             */
+            size_t getDroppedItems() const { return droppedItems_.load(std::memory_order_relaxed); }
+
+        private:
+            void receive(TYPE const &item, const Topic<TYPE> *topic) override
+            {
+                if (!this->placeFront(item))
+                    droppedItems_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void receiveMove(TYPE &&item, const Topic<TYPE> *topic) override
+            {
+                if (!this->placeFront(std::move(item)))
+                    droppedItems_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void receiveBatch(const TYPE *items, size_t numItems, const Topic<TYPE> *topic) override
+            {
+                size_t placed = this->placeFrontN(items, numItems);
+                if (placed < numItems)
+                    droppedItems_.fetch_add(numItems - placed, std::memory_order_relaxed);
+            }
+
+            std::atomic<size_t> droppedItems_;
+        };
+
         /**
          * This subscriber calls the given function passing the data received form topic to it.
          */
@@ -134,9 +228,9 @@ namespace VCTR
              */
             Callback_Subscriber(Topic<TYPE> &topic)
             {
-                subscribe(topic);
                 callbackFunc_ = nullptr;
                 object_ = nullptr;
+                this->subscribe(topic);
             }
 
             /**
@@ -147,9 +241,9 @@ namespace VCTR
              */
             Callback_Subscriber(Topic<TYPE> &topic, CALLBACKTYPE *objectPointer, void (CALLBACKTYPE::*callbackFunc)(const TYPE &))
             {
-                subscribe(topic);
                 callbackFunc_ = callbackFunc;
                 object_ = objectPointer;
+                this->subscribe(topic);
             }
 
             /**
@@ -197,8 +291,8 @@ namespace VCTR
              */
             StaticCallback_Subscriber(Topic<TYPE> &topic, void (*callbackFunc)(TYPE const &item))
             {
-                subscribe(topic);
                 callbackFunc_ = callbackFunc;
+                this->subscribe(topic);
             }
 
             /**
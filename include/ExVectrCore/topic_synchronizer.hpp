@@ -0,0 +1,295 @@
+#ifndef EXVECTRCORE_TOPICSYNCHRONIZER_HPP
+#define EXVECTRCORE_TOPICSYNCHRONIZER_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "list_buffer.hpp"
+#include "timestamped.hpp"
+#include "topic.hpp"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Matches items from multiple timestamped topics and publishes them together once all their timestamps are within a tolerance.
+         * Each input topic is buffered in its own ring. On every received item, the oldest item of each ring are compared:
+         * - If all are within the tolerance of each other they are published as a tuple and removed.
+         * - Otherwise the oldest of them can no longer be matched (all other items are newer than tolerance allows) and is dropped.
+         * This is a linear merge, so every item is looked at a constant number of times.
+         * If a ring is full the oldest item is overwritten, so memory is bounded by DEPTH items per topic.
+         * e.g.
+         *      Topic<Timestamped<Imu>> imuTopic;
+         *      Topic<Timestamped<Baro>> baroTopic;
+         *      Topic_Synchronizer<8, Imu, Baro> sync(1 * MILLISECONDS, imuTopic, baroTopic);
+         *      Simple_Subscriber<std::tuple<Timestamped<Imu>, Timestamped<Baro>>> matched(sync.getTopic());
+         *
+         * @tparam DEPTH Number of items buffered per topic.
+         * @tparam TYPES Data types of the timestamped topics.
+         */
+        template <size_t DEPTH, typename... TYPES>
+        class Topic_Synchronizer
+        {
+            static_assert(sizeof...(TYPES) > 1, "Topic_Synchronizer needs at least 2 topics.");
+            static_assert(DEPTH > 0, "Topic_Synchronizer needs a depth of at least 1.");
+
+        public:
+            /// @brief Type published by the synchronizer.
+            typedef std::tuple<Timestamped<TYPES>...> Sync_Tuple;
+
+        private:
+            /// @brief Number of input topics.
+            static constexpr size_t NUM_TOPICS = sizeof...(TYPES);
+
+            /// @brief Tag used to iterate over the channels at compile time.
+            template <size_t I>
+            using Index = std::integral_constant<size_t, I>;
+
+            /**
+             * Buffers the items of one input topic.
+             */
+            template <typename T>
+            class Sync_Channel : public Subscriber<Timestamped<T>>
+            {
+                friend Topic_Synchronizer;
+
+            private:
+                Topic_Synchronizer *sync_ = nullptr;
+                // Received items. Oldest at back.
+                ListBuffer<Timestamped<T>, DEPTH> items_;
+                // Items dropped because no match was found.
+                size_t dropped_ = 0;
+                // Items overwritten because the ring was full.
+                size_t overflows_ = 0;
+
+                void receive(const Timestamped<T> &item, const Topic<Timestamped<T>> *topic) override
+                {
+                    if (items_.size() == items_.sizeMax())
+                        overflows_++;
+                    items_.placeFront(item, true);
+                    sync_->process();
+                }
+            };
+
+            /// @brief One channel per input topic.
+            std::tuple<Sync_Channel<TYPES>...> channels_;
+            /// @brief Matched items are published here.
+            Topic<Sync_Tuple> topic_;
+            /// @brief Max time between the oldest and newest item of a match in ns.
+            int64_t tolerance_ = 0;
+            /// @brief Number of published matches.
+            size_t matched_ = 0;
+            /// @brief Guards against a subscriber publishing into an input topic while a match is published.
+            bool processing_ = false;
+
+        public:
+            /**
+             * @param tolerance Max time between the oldest and newest item of a match in ns.
+             */
+            Topic_Synchronizer(int64_t tolerance)
+            {
+                tolerance_ = tolerance;
+                initChannels(Index<0>());
+            }
+
+            /**
+             * @param tolerance Max time between the oldest and newest item of a match in ns.
+             * @param topics Topics to synchronize. Must match TYPES in order.
+             */
+            template <typename... TOPICS>
+            Topic_Synchronizer(int64_t tolerance, TOPICS &...topics) : Topic_Synchronizer(tolerance)
+            {
+                static_assert(sizeof...(TOPICS) == NUM_TOPICS, "Topic_Synchronizer needs one topic per type.");
+                subscribeTopics(Index<0>(), topics...);
+            }
+
+            Topic_Synchronizer(const Topic_Synchronizer &) = delete;
+            Topic_Synchronizer &operator=(const Topic_Synchronizer &) = delete;
+
+            /**
+             * @brief Subscribes the input with given index to the topic.
+             * @tparam I Index of input. Same order as TYPES.
+             * @param topic Topic to synchronize.
+             */
+            template <size_t I>
+            void subscribe(Topic<Timestamped<typename std::tuple_element<I, std::tuple<TYPES...>>::type>> &topic)
+            {
+                std::get<I>(channels_).subscribe(topic);
+            }
+
+            /**
+             * @returns the topic matched items are published to.
+             */
+            Topic<Sync_Tuple> &getTopic()
+            {
+                return topic_;
+            }
+
+            /**
+             * @brief Sets the max time between the oldest and newest item of a match.
+             * @param tolerance Tolerance in ns.
+             */
+            void setTolerance(int64_t tolerance)
+            {
+                tolerance_ = tolerance;
+            }
+
+            /**
+             * @returns number of published matches.
+             */
+            size_t getMatched() const
+            {
+                return matched_;
+            }
+
+            /**
+             * @tparam I Index of input. Same order as TYPES.
+             * @returns number of items of given input dropped because no match was found.
+             */
+            template <size_t I>
+            size_t getDropped() const
+            {
+                return std::get<I>(channels_).dropped_;
+            }
+
+            /**
+             * @tparam I Index of input. Same order as TYPES.
+             * @returns number of items of given input overwritten because its ring was full.
+             */
+            template <size_t I>
+            size_t getOverflows() const
+            {
+                return std::get<I>(channels_).overflows_;
+            }
+
+            /**
+             * @brief Removes all buffered items.
+             */
+            void clear()
+            {
+                clearChannels(Index<0>());
+            }
+
+        private:
+            /**
+             * Publishes all possible matches and drops items that can no longer be matched.
+             */
+            void process()
+            {
+
+                if (processing_)
+                    return;
+                processing_ = true;
+
+                while (allHaveItems(Index<0>()))
+                {
+
+                    int64_t oldest = 0, newest = 0;
+                    size_t oldestIndex = 0;
+                    getRange(Index<0>(), oldest, newest, oldestIndex);
+
+                    if (newest - oldest > tolerance_)
+                    {
+                        dropOldest(Index<0>(), oldestIndex);
+                        continue;
+                    }
+
+                    Sync_Tuple match;
+                    takeMatch(Index<0>(), match);
+                    matched_++;
+                    topic_.publish(std::move(match));
+                }
+
+                processing_ = false;
+            }
+
+            template <size_t I>
+            void initChannels(Index<I>)
+            {
+                std::get<I>(channels_).sync_ = this;
+                initChannels(Index<I + 1>());
+            }
+
+            void initChannels(Index<NUM_TOPICS>) {}
+
+            template <size_t I, typename TOPIC, typename... TOPICS>
+            void subscribeTopics(Index<I>, TOPIC &topic, TOPICS &...topics)
+            {
+                std::get<I>(channels_).subscribe(topic);
+                subscribeTopics(Index<I + 1>(), topics...);
+            }
+
+            void subscribeTopics(Index<NUM_TOPICS>) {}
+
+            template <size_t I>
+            bool allHaveItems(Index<I>) const
+            {
+                return std::get<I>(channels_).items_.size() > 0 && allHaveItems(Index<I + 1>());
+            }
+
+            bool allHaveItems(Index<NUM_TOPICS>) const { return true; }
+
+            template <size_t I>
+            void getRange(Index<I>, int64_t &oldest, int64_t &newest, size_t &oldestIndex) const
+            {
+                const auto &items = std::get<I>(channels_).items_;
+                int64_t time = items[items.size() - 1].timestamp;
+
+                if (I == 0 || time < oldest)
+                {
+                    oldest = time;
+                    oldestIndex = I;
+                }
+                if (I == 0 || time > newest)
+                    newest = time;
+
+                getRange(Index<I + 1>(), oldest, newest, oldestIndex);
+            }
+
+            void getRange(Index<NUM_TOPICS>, int64_t &oldest, int64_t &newest, size_t &oldestIndex) const {}
+
+            template <size_t I>
+            void dropOldest(Index<I>, size_t index)
+            {
+                if (I == index)
+                {
+                    std::get<I>(channels_).items_.removeBack();
+                    std::get<I>(channels_).dropped_++;
+                    return;
+                }
+                dropOldest(Index<I + 1>(), index);
+            }
+
+            void dropOldest(Index<NUM_TOPICS>, size_t index) {}
+
+            template <size_t I>
+            void takeMatch(Index<I>, Sync_Tuple &match)
+            {
+                std::get<I>(channels_).items_.takeBack(std::get<I>(match));
+                takeMatch(Index<I + 1>(), match);
+            }
+
+            void takeMatch(Index<NUM_TOPICS>, Sync_Tuple &match) {}
+
+            template <size_t I>
+            void clearChannels(Index<I>)
+            {
+                std::get<I>(channels_).items_.clear();
+                clearChannels(Index<I + 1>());
+            }
+
+            void clearChannels(Index<NUM_TOPICS>) {}
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef EXVECTRCORE_TYPEID_HPP
+#define EXVECTRCORE_TYPEID_HPP
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        /**
+         * @brief Identifies a type at runtime without RTTI. Two TypeIds are equal only if they belong to the same type.
+         */
+        typedef const void *TypeId;
+
+        /**
+         * @brief Gets the unique id of the given type. Cheap, as the id is the address of a static variable.
+         * The variable is not const, so identical code folding (e.g. --icf=all) cannot merge the ids of different types.
+         * @tparam TYPE Type to get id of.
+         * @returns the id of the type.
+         */
+        template <typename TYPE>
+        TypeId getTypeId()
+        {
+            static char id = 0;
+            return &id;
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,580 @@
+#include "ExVectrCore/allocator.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+
+namespace
+{
+
+    /// @brief Rounds value up to a multiple of alignment. Alignment must be a power of two.
+    inline uintptr_t alignUp(uintptr_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~uintptr_t(alignment - 1);
+    }
+
+    /// @brief Index of highest set bit. Value must not be 0.
+    inline size_t highestBit(size_t value)
+    {
+#if defined(__GNUC__)
+        return sizeof(size_t) * 8 - 1 - (sizeof(size_t) > sizeof(unsigned int) ? __builtin_clzll(value) : __builtin_clz(value));
+#else
+        size_t bit = 0;
+        while (value >>= 1)
+            bit++;
+        return bit;
+#endif
+    }
+
+    /// @brief Index of lowest set bit. Value must not be 0.
+    inline size_t lowestBit(uint32_t value)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz(value);
+#else
+        size_t bit = 0;
+        while ((value & 1) == 0)
+        {
+            value >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    /**
+     * @brief Allocator using the global heap.
+     */
+    class Allocator_Heap : public VCTR::Core::Allocator
+    {
+    public:
+        void *allocate(size_t size, size_t alignment) override
+        {
+            // malloc always aligns for fundamental types, larger alignments are not supported.
+            void *ptr = alignment <= DEFAULT_ALIGNMENT && size > 0 ? malloc(size) : nullptr;
+            if (ptr == nullptr)
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            recordAllocation(size);
+            return ptr;
+        }
+
+        void deallocate(void *ptr, size_t size) override
+        {
+            if (ptr == nullptr)
+                return;
+
+            free(ptr);
+            recordFree(size);
+        }
+
+        void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment) override
+        {
+            if (ptr == nullptr)
+                return allocate(newSize, alignment);
+
+            if (newSize == 0)
+            {
+                deallocate(ptr, oldSize);
+                return nullptr;
+            }
+
+            void *newPtr = realloc(ptr, newSize);
+            if (newPtr == nullptr)
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            recordFree(oldSize);
+            recordAllocation(newSize);
+            return newPtr;
+        }
+    };
+
+} // namespace to hide local functions and classes.
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        constexpr size_t Allocator::DEFAULT_ALIGNMENT;
+        constexpr size_t Allocator_TLSF::ALIGNMENT;
+
+        Allocator &getHeapAllocator()
+        {
+            static Allocator_Heap allocator;
+            return allocator;
+        }
+
+        void *Allocator::reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment)
+        {
+
+            if (ptr == nullptr)
+                return allocate(newSize, alignment);
+
+            if (newSize == 0)
+            {
+                deallocate(ptr, oldSize);
+                return nullptr;
+            }
+
+            void *newPtr = allocate(newSize, alignment);
+            if (newPtr == nullptr)
+                return nullptr;
+
+            memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+            deallocate(ptr, oldSize);
+
+            return newPtr;
+        }
+
+        void Allocator::recordAllocation(size_t size)
+        {
+            stats_.numAllocations++;
+            stats_.bytesInUse += size;
+            if (stats_.bytesInUse > stats_.peakBytesInUse)
+                stats_.peakBytesInUse = stats_.bytesInUse;
+        }
+
+        void Allocator::recordFree(size_t size)
+        {
+            stats_.numFrees++;
+            stats_.bytesInUse -= size;
+        }
+
+        void Allocator::recordFailure()
+        {
+            stats_.numFailures++;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Allocator_Arena
+
+        Allocator_Arena::Allocator_Arena(void *memory, size_t size)
+        {
+            start_ = static_cast<uint8_t *>(memory);
+            end_ = start_ + size;
+            current_ = start_;
+            stats_.capacity = size;
+        }
+
+        void *Allocator_Arena::allocate(size_t size, size_t alignment)
+        {
+
+            uint8_t *ptr = reinterpret_cast<uint8_t *>(alignUp(uintptr_t(current_), alignment));
+            if (size == 0 || ptr > end_ || size_t(end_ - ptr) < size)
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            // Alignment padding counts as used, as it is only given back on reset().
+            recordAllocation(ptr + size - current_);
+
+            last_ = ptr;
+            current_ = ptr + size;
+
+            return ptr;
+        }
+
+        void Allocator_Arena::deallocate(void *ptr, size_t)
+        {
+
+            if (ptr == nullptr)
+                return;
+
+            stats_.numFrees++;
+
+            // Only the last allocation can be given back.
+            if (ptr == last_)
+            {
+                stats_.bytesInUse -= current_ - last_;
+                current_ = last_;
+                last_ = nullptr;
+            }
+        }
+
+        void *Allocator_Arena::reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment)
+        {
+
+            // The last allocation can grow or shrink in place.
+            if (ptr != nullptr && ptr == last_ && newSize > 0)
+            {
+                if (size_t(end_ - last_) < newSize)
+                {
+                    recordFailure();
+                    return nullptr;
+                }
+
+                stats_.bytesInUse = stats_.bytesInUse - (current_ - last_) + newSize;
+                if (stats_.bytesInUse > stats_.peakBytesInUse)
+                    stats_.peakBytesInUse = stats_.bytesInUse;
+
+                current_ = last_ + newSize;
+                return ptr;
+            }
+
+            return Allocator::reallocate(ptr, oldSize, newSize, alignment);
+        }
+
+        void Allocator_Arena::reset()
+        {
+            current_ = start_;
+            last_ = nullptr;
+            stats_.bytesInUse = 0;
+        }
+
+        size_t Allocator_Arena::getRemaining() const
+        {
+            return end_ - current_;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Allocator_Pool
+
+        Allocator_Pool::Allocator_Pool(void *memory, size_t size, size_t blockSize)
+        {
+
+            blockSize_ = alignUp(blockSize < sizeof(Free_Block) ? sizeof(Free_Block) : blockSize, DEFAULT_ALIGNMENT);
+
+            uint8_t *start = reinterpret_cast<uint8_t *>(alignUp(uintptr_t(memory), DEFAULT_ALIGNMENT));
+            size_t usable = size > size_t(start - static_cast<uint8_t *>(memory)) ? size - (start - static_cast<uint8_t *>(memory)) : 0;
+
+            numBlocks_ = usable / blockSize_;
+            numFree_ = numBlocks_;
+            stats_.capacity = numBlocks_ * blockSize_;
+
+            // Chain blocks so the first block is given out first.
+            for (size_t i = numBlocks_; i > 0; i--)
+            {
+                Free_Block *block = reinterpret_cast<Free_Block *>(start + (i - 1) * blockSize_);
+                block->next = freeList_;
+                freeList_ = block;
+            }
+        }
+
+        void *Allocator_Pool::allocate(size_t size, size_t alignment)
+        {
+
+            if (freeList_ == nullptr || size == 0 || size > blockSize_ || alignment > DEFAULT_ALIGNMENT)
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            Free_Block *block = freeList_;
+            freeList_ = block->next;
+            numFree_--;
+
+            recordAllocation(blockSize_);
+
+            return block;
+        }
+
+        void Allocator_Pool::deallocate(void *ptr, size_t)
+        {
+
+            if (ptr == nullptr)
+                return;
+
+            Free_Block *block = static_cast<Free_Block *>(ptr);
+            block->next = freeList_;
+            freeList_ = block;
+            numFree_++;
+
+            recordFree(blockSize_);
+        }
+
+        void *Allocator_Pool::reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment)
+        {
+
+            // Every block has the same size, so anything that fits stays where it is.
+            if (ptr != nullptr && newSize > 0)
+            {
+                if (newSize <= blockSize_)
+                    return ptr;
+
+                recordFailure();
+                return nullptr;
+            }
+
+            return Allocator::reallocate(ptr, oldSize, newSize, alignment);
+        }
+
+        size_t Allocator_Pool::getBlockSize() const
+        {
+            return blockSize_;
+        }
+
+        size_t Allocator_Pool::getNumBlocks() const
+        {
+            return numBlocks_;
+        }
+
+        size_t Allocator_Pool::getNumFree() const
+        {
+            return numFree_;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Allocator_TLSF
+
+        Allocator_TLSF::Allocator_TLSF(void *memory, size_t size)
+        {
+
+            uint8_t *start = reinterpret_cast<uint8_t *>(alignUp(uintptr_t(memory), ALIGNMENT));
+            size_t usable = size > size_t(start - static_cast<uint8_t *>(memory)) ? size - (start - static_cast<uint8_t *>(memory)) : 0;
+            usable &= ~(ALIGNMENT - 1);
+
+            if (usable > (size_t(1) << FL_MAX) - ALIGNMENT)
+                usable = (size_t(1) << FL_MAX) - ALIGNMENT;
+
+            // Needs space for one block and the end marker.
+            if (usable < 2 * HEADER_SIZE + MIN_BLOCK_SIZE)
+                return;
+
+            Block *block = reinterpret_cast<Block *>(start);
+            block->prevPhysical = nullptr;
+            block->size = usable - 2 * HEADER_SIZE;
+
+            // Used zero size block at the end, so the last real block never merges past it.
+            Block *end = nextPhysical(block);
+            end->prevPhysical = block;
+            end->size = 0;
+
+            stats_.capacity = blockSize(block);
+
+            insertFree(block);
+        }
+
+        void *Allocator_TLSF::allocate(size_t size, size_t alignment)
+        {
+
+            if (size == 0 || alignment > ALIGNMENT || size > (size_t(1) << FL_MAX))
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            size = alignUp(size < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : size, ALIGNMENT);
+
+            Block *block = findFree(size);
+            if (block == nullptr)
+            {
+                recordFailure();
+                return nullptr;
+            }
+
+            // Mark used before splitting, so the remainder does not merge back into it.
+            block->size &= ~size_t(1);
+            split(block, size);
+
+            recordAllocation(blockSize(block));
+
+            return toMemory(block);
+        }
+
+        void Allocator_TLSF::deallocate(void *ptr, size_t)
+        {
+
+            if (ptr == nullptr)
+                return;
+
+            Block *block = toBlock(ptr);
+            recordFree(blockSize(block));
+
+            block->size |= 1;
+            insertFree(merge(block));
+        }
+
+        void *Allocator_TLSF::reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment)
+        {
+
+            if (ptr == nullptr || newSize == 0 || alignment > ALIGNMENT)
+                return Allocator::reallocate(ptr, oldSize, newSize, alignment);
+
+            Block *block = toBlock(ptr);
+            size_t oldBlockSize = blockSize(block);
+            size_t size = alignUp(newSize < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : newSize, ALIGNMENT);
+
+            // Grow in place by taking the following free block.
+            Block *next = nextPhysical(block);
+            if (size > oldBlockSize && isFree(next) && oldBlockSize + HEADER_SIZE + blockSize(next) >= size)
+            {
+                removeFree(next);
+                block->size += HEADER_SIZE + blockSize(next);
+                nextPhysical(block)->prevPhysical = block;
+            }
+
+            if (size > blockSize(block))
+                return Allocator::reallocate(ptr, oldSize, newSize, alignment);
+
+            // Fits, give back what is not needed.
+            split(block, size);
+
+            stats_.bytesInUse = stats_.bytesInUse - oldBlockSize + blockSize(block);
+            if (stats_.bytesInUse > stats_.peakBytesInUse)
+                stats_.peakBytesInUse = stats_.bytesInUse;
+
+            return ptr;
+        }
+
+        size_t Allocator_TLSF::blockSize(const Block *block)
+        {
+            return block->size & ~size_t(1);
+        }
+
+        bool Allocator_TLSF::isFree(const Block *block)
+        {
+            return (block->size & 1) != 0;
+        }
+
+        Allocator_TLSF::Block *Allocator_TLSF::nextPhysical(const Block *block)
+        {
+            return reinterpret_cast<Block *>(reinterpret_cast<uint8_t *>(const_cast<Block *>(block)) + HEADER_SIZE + blockSize(block));
+        }
+
+        void *Allocator_TLSF::toMemory(Block *block)
+        {
+            return reinterpret_cast<uint8_t *>(block) + HEADER_SIZE;
+        }
+
+        Allocator_TLSF::Block *Allocator_TLSF::toBlock(void *memory)
+        {
+            return reinterpret_cast<Block *>(static_cast<uint8_t *>(memory) - HEADER_SIZE);
+        }
+
+        void Allocator_TLSF::mapping(size_t size, size_t &fl, size_t &sl)
+        {
+
+            if (size < SMALL_BLOCK)
+            {
+                fl = 0;
+                sl = size / (SMALL_BLOCK / SL_COUNT);
+                return;
+            }
+
+            size_t bit = highestBit(size);
+            sl = (size >> (bit - SL_BITS)) ^ SL_COUNT;
+            fl = bit - FL_SHIFT + 1;
+        }
+
+        Allocator_TLSF::Block *Allocator_TLSF::findFree(size_t size)
+        {
+
+            // Round up to the next size class, so every block in the found class fits.
+            if (size >= SMALL_BLOCK)
+                size += (size_t(1) << (highestBit(size) - SL_BITS)) - 1;
+
+            size_t fl, sl;
+            mapping(size, fl, sl);
+            if (fl >= FL_COUNT)
+                return nullptr;
+
+            uint32_t slMap = slBitmap_[fl] & (~uint32_t(0) << sl);
+            if (slMap == 0)
+            {
+                // No block in this first level, take the smallest larger one.
+                uint32_t flMap = fl + 1 < 32 ? flBitmap_ & (~uint32_t(0) << (fl + 1)) : 0;
+                if (flMap == 0)
+                    return nullptr;
+
+                fl = lowestBit(flMap);
+                slMap = slBitmap_[fl];
+            }
+
+            Block *block = freeLists_[fl][lowestBit(slMap)];
+            removeFree(block);
+
+            return block;
+        }
+
+        void Allocator_TLSF::insertFree(Block *block)
+        {
+
+            size_t fl, sl;
+            mapping(blockSize(block), fl, sl);
+
+            Block *head = freeLists_[fl][sl];
+            block->nextFree = head;
+            block->prevFree = nullptr;
+            if (head != nullptr)
+                head->prevFree = block;
+
+            freeLists_[fl][sl] = block;
+            flBitmap_ |= uint32_t(1) << fl;
+            slBitmap_[fl] |= uint32_t(1) << sl;
+        }
+
+        void Allocator_TLSF::removeFree(Block *block)
+        {
+
+            size_t fl, sl;
+            mapping(blockSize(block), fl, sl);
+
+            if (block->prevFree != nullptr)
+                block->prevFree->nextFree = block->nextFree;
+            else
+                freeLists_[fl][sl] = block->nextFree;
+
+            if (block->nextFree != nullptr)
+                block->nextFree->prevFree = block->prevFree;
+
+            if (freeLists_[fl][sl] == nullptr)
+            {
+                slBitmap_[fl] &= ~(uint32_t(1) << sl);
+                if (slBitmap_[fl] == 0)
+                    flBitmap_ &= ~(uint32_t(1) << fl);
+            }
+        }
+
+        void Allocator_TLSF::split(Block *block, size_t size)
+        {
+
+            size_t currentSize = blockSize(block);
+            if (currentSize < size + HEADER_SIZE + MIN_BLOCK_SIZE)
+                return;
+
+            Block *remaining = reinterpret_cast<Block *>(static_cast<uint8_t *>(toMemory(block)) + size);
+            remaining->prevPhysical = block;
+            remaining->size = (currentSize - size - HEADER_SIZE) | 1;
+
+            block->size = size | (block->size & 1);
+
+            remaining = merge(remaining);
+            insertFree(remaining);
+        }
+
+        Allocator_TLSF::Block *Allocator_TLSF::merge(Block *block)
+        {
+
+            Block *next = nextPhysical(block);
+            if (isFree(next))
+            {
+                removeFree(next);
+                block->size += HEADER_SIZE + blockSize(next);
+            }
+
+            Block *prev = block->prevPhysical;
+            if (prev != nullptr && isFree(prev))
+            {
+                removeFree(prev);
+                prev->size += HEADER_SIZE + blockSize(block);
+                block = prev;
+            }
+
+            nextPhysical(block)->prevPhysical = block;
+
+            return block;
+        }
+
+    }
+
+}
@@ -0,0 +1,501 @@
+#include "ExVectrCore/data_log.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include "ExVectrCore/cyclic_checksum.hpp"
+#include "ExVectrCore/time_definitions.hpp"
+
+namespace
+{
+    /// @brief Magic at start of log file. Followed by version.
+    const char fileMagic[7] = {'V', 'C', 'T', 'R', 'L', 'O', 'G'};
+    /// @brief Magic at start of each chunk header.
+    const char chunkMagic[4] = {'C', 'H', 'N', 'K'};
+    /// @brief Initial value for the chunk CRC.
+    constexpr int32_t crcInitialValue = 0xFFFF;
+
+} // namespace to hide local variables.
+
+// DataLog_ChunkHeader
+
+void VCTR::Core::DataLog_ChunkHeader::serialize(uint8_t *buffer) const
+{
+    memcpy(buffer, chunkMagic, 4);
+    memcpy(buffer + 4, &payloadSize, 4);
+    memcpy(buffer + 8, &numRecords, 4);
+    memcpy(buffer + 12, &crc, 4);
+    memcpy(buffer + 16, &firstTimestamp, 8);
+    memcpy(buffer + 24, &lastTimestamp, 8);
+}
+
+bool VCTR::Core::DataLog_ChunkHeader::deserialize(const uint8_t *buffer)
+{
+    if (memcmp(buffer, chunkMagic, 4) != 0)
+        return false;
+
+    memcpy(&payloadSize, buffer + 4, 4);
+    memcpy(&numRecords, buffer + 8, 4);
+    memcpy(&crc, buffer + 12, 4);
+    memcpy(&firstTimestamp, buffer + 16, 8);
+    memcpy(&lastTimestamp, buffer + 24, 8);
+
+    return true;
+}
+
+// DataLog_Writer
+
+VCTR::Core::DataLog_Writer::DataLog_Writer(DataLog_Storage &storage, size_t chunkSize, size_t numChunks, int64_t flushInterval_ns, int64_t maxChunkAge_ns) : Task_Periodic("DataLog_Writer", flushInterval_ns)
+{
+    if (numChunks < 2)
+        numChunks = 2;
+
+    storage_ = &storage;
+    chunkSize_ = chunkSize;
+    numChunks_ = numChunks;
+    maxChunkAge_ = maxChunkAge_ns;
+
+    // Allocated once. Chunks are reused so no further heap usage.
+    chunkMemory_ = new uint8_t[chunkSize_ * numChunks_];
+    chunkHeaders_ = new DataLog_ChunkHeader[numChunks_];
+}
+
+VCTR::Core::DataLog_Writer::~DataLog_Writer()
+{
+    flush();
+
+    delete[] chunkMemory_;
+    delete[] chunkHeaders_;
+}
+
+bool VCTR::Core::DataLog_Writer::record(uint16_t channel, int64_t timestamp, const void *data, uint16_t size)
+{
+
+    size_t recordSize = DATALOG_RECORDHEADER_SIZE + size;
+
+    if (recordSize > chunkSize_) // Would never fit.
+    {
+        droppedRecords_++;
+        return false;
+    }
+
+    if (chunkHeaders_[fillChunk_].payloadSize + recordSize > chunkSize_ && !sealChunk())
+    {
+        droppedRecords_++;
+        return false;
+    }
+
+    DataLog_ChunkHeader &header = chunkHeaders_[fillChunk_];
+    uint8_t *recordPtr = getPayload(fillChunk_) + header.payloadSize;
+
+    memcpy(recordPtr, &channel, 2);
+    memcpy(recordPtr + 2, &size, 2);
+    memcpy(recordPtr + 4, &timestamp, 8);
+    memcpy(recordPtr + DATALOG_RECORDHEADER_SIZE, data, size);
+
+    if (header.numRecords == 0)
+    {
+        header.firstTimestamp = timestamp;
+        header.lastTimestamp = timestamp;
+        fillChunkStart_ = NOW();
+    }
+    else if (timestamp < header.firstTimestamp) // Records from multiple channels do not have to be in order.
+        header.firstTimestamp = timestamp;
+    else if (timestamp > header.lastTimestamp)
+        header.lastTimestamp = timestamp;
+
+    header.numRecords++;
+    header.payloadSize += recordSize;
+    numRecords_++;
+
+    return true;
+}
+
+void VCTR::Core::DataLog_Writer::flush()
+{
+
+    if (chunkHeaders_[fillChunk_].numRecords > 0 && !sealChunk())
+    {
+        writeSealedChunks(); // Make space to seal the current chunk.
+        sealChunk();
+    }
+
+    writeSealedChunks();
+}
+
+size_t VCTR::Core::DataLog_Writer::getDroppedRecords() const
+{
+    return droppedRecords_;
+}
+
+size_t VCTR::Core::DataLog_Writer::getNumRecords() const
+{
+    return numRecords_;
+}
+
+size_t VCTR::Core::DataLog_Writer::getWriteErrors() const
+{
+    return writeErrors_;
+}
+
+void VCTR::Core::DataLog_Writer::taskThread()
+{
+
+    if (chunkHeaders_[fillChunk_].numRecords > 0 && NOW() - fillChunkStart_ >= maxChunkAge_)
+        sealChunk();
+
+    writeSealedChunks();
+}
+
+uint8_t *VCTR::Core::DataLog_Writer::getPayload(size_t chunk)
+{
+    return chunkMemory_ + chunk * chunkSize_;
+}
+
+bool VCTR::Core::DataLog_Writer::sealChunk()
+{
+
+    if (sealedChunks_ + 1 >= numChunks_) // All other chunks are still waiting to be written.
+        return false;
+
+    DataLog_ChunkHeader &header = chunkHeaders_[fillChunk_];
+    header.crc = computeCrc(getPayload(fillChunk_), header.payloadSize, crcInitialValue);
+
+    sealedChunks_++;
+    fillChunk_ = (fillChunk_ + 1) % numChunks_;
+    chunkHeaders_[fillChunk_] = DataLog_ChunkHeader();
+
+    return true;
+}
+
+void VCTR::Core::DataLog_Writer::writeSealedChunks()
+{
+
+    if (sealedChunks_ == 0)
+        return;
+
+    if (!headerWritten_)
+    {
+        uint8_t fileHeader[DATALOG_FILEHEADER_SIZE] = {0};
+        memcpy(fileHeader, fileMagic, 7);
+        fileHeader[7] = DATALOG_VERSION;
+        uint32_t maxPayloadSize = chunkSize_;
+        memcpy(fileHeader + 8, &maxPayloadSize, 4);
+
+        storage_->write(fileHeader, DATALOG_FILEHEADER_SIZE);
+        headerWritten_ = true;
+    }
+
+    while (sealedChunks_ > 0)
+    {
+        const DataLog_ChunkHeader &header = chunkHeaders_[writeChunk_];
+
+        uint8_t headerBuffer[DATALOG_CHUNKHEADER_SIZE];
+        header.serialize(headerBuffer);
+
+        size_t written = storage_->write(headerBuffer, DATALOG_CHUNKHEADER_SIZE);
+        written += storage_->write(getPayload(writeChunk_), header.payloadSize);
+
+        if (written != DATALOG_CHUNKHEADER_SIZE + header.payloadSize)
+            writeErrors_++;
+
+        writeChunk_ = (writeChunk_ + 1) % numChunks_;
+        sealedChunks_--;
+    }
+
+    storage_->flush();
+}
+
+// DataLog_Reader
+
+VCTR::Core::DataLog_Reader::DataLog_Reader(DataLog_Storage &storage)
+{
+    storage_ = &storage;
+}
+
+bool VCTR::Core::DataLog_Reader::open()
+{
+
+    chunkIndex_.clear();
+    currentChunk_ = 0;
+    chunkLoaded_ = false;
+
+    uint8_t fileHeader[DATALOG_FILEHEADER_SIZE];
+    if (!storage_->seek(0) || storage_->read(fileHeader, DATALOG_FILEHEADER_SIZE) != DATALOG_FILEHEADER_SIZE)
+        return false;
+
+    if (memcmp(fileHeader, fileMagic, 7) != 0 || fileHeader[7] != DATALOG_VERSION)
+        return false;
+
+    // 0 in logs from writers that did not store it.
+    uint32_t maxPayloadSize;
+    memcpy(&maxPayloadSize, fileHeader + 8, 4);
+
+    // Only the chunk headers are read. Payloads are skipped.
+    // The CRC only covers the payload, so the payload size is checked before it is used to find the next chunk.
+    size_t position = DATALOG_FILEHEADER_SIZE;
+    uint8_t headerBuffer[DATALOG_CHUNKHEADER_SIZE];
+    DataLog_ChunkIndex index;
+    while (storage_->read(headerBuffer, DATALOG_CHUNKHEADER_SIZE) == DATALOG_CHUNKHEADER_SIZE && index.header.deserialize(headerBuffer))
+    {
+        if (maxPayloadSize != 0 && index.header.payloadSize > maxPayloadSize)
+            break;
+
+        size_t next = position + DATALOG_CHUNKHEADER_SIZE + index.header.payloadSize;
+
+        // Last payload byte must be in storage.
+        uint8_t lastByte;
+        if (index.header.payloadSize > 0 && (!storage_->seek(next - 1) || storage_->read(&lastByte, 1) != 1))
+            break;
+
+        index.position = position;
+        chunkIndex_.append(index);
+
+        position = next;
+        if (!storage_->seek(position))
+            break;
+    }
+
+    return true;
+}
+
+const VCTR::Core::List<VCTR::Core::DataLog_ChunkIndex> &VCTR::Core::DataLog_Reader::getChunkIndex() const
+{
+    return chunkIndex_;
+}
+
+int64_t VCTR::Core::DataLog_Reader::getStartTime() const
+{
+
+    if (chunkIndex_.size() == 0)
+        return 0;
+
+    return chunkIndex_[0].header.firstTimestamp;
+}
+
+int64_t VCTR::Core::DataLog_Reader::getEndTime() const
+{
+
+    if (chunkIndex_.size() == 0)
+        return 0;
+
+    return chunkIndex_[chunkIndex_.size() - 1].header.lastTimestamp;
+}
+
+bool VCTR::Core::DataLog_Reader::seekTime(int64_t timestamp)
+{
+
+    // Binary search for the first chunk whose last record is not before the given time.
+    size_t low = 0;
+    size_t high = chunkIndex_.size();
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (chunkIndex_[mid].header.lastTimestamp < timestamp)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    currentChunk_ = low;
+    chunkLoaded_ = false;
+
+    return currentChunk_ < chunkIndex_.size();
+}
+
+bool VCTR::Core::DataLog_Reader::nextRecord(uint16_t &channel, int64_t &timestamp, const uint8_t *&data, uint16_t &size)
+{
+
+    while (currentChunk_ < chunkIndex_.size())
+    {
+
+        if (!chunkLoaded_)
+        {
+            if (!loadChunk(currentChunk_))
+            {
+                currentChunk_++;
+                continue;
+            }
+            chunkLoaded_ = true;
+            payloadPos_ = 0;
+        }
+
+        if (payloadPos_ + DATALOG_RECORDHEADER_SIZE > payload_.size()) // End of chunk.
+        {
+            currentChunk_++;
+            chunkLoaded_ = false;
+            continue;
+        }
+
+        const uint8_t *recordPtr = &payload_[payloadPos_];
+        memcpy(&channel, recordPtr, 2);
+        memcpy(&size, recordPtr + 2, 2);
+        memcpy(&timestamp, recordPtr + 4, 8);
+        data = recordPtr + DATALOG_RECORDHEADER_SIZE;
+
+        payloadPos_ += DATALOG_RECORDHEADER_SIZE + size;
+
+        if (payloadPos_ > payload_.size()) // Should not happen if CRC is correct.
+        {
+            currentChunk_++;
+            chunkLoaded_ = false;
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+size_t VCTR::Core::DataLog_Reader::getCrcErrors() const
+{
+    return crcErrors_;
+}
+
+bool VCTR::Core::DataLog_Reader::loadChunk(size_t chunk)
+{
+
+    const DataLog_ChunkIndex &index = chunkIndex_[chunk];
+    size_t payloadSize = index.header.payloadSize;
+
+    payload_.setSize(payloadSize);
+    if (payloadSize == 0)
+        return true;
+
+    if (!storage_->seek(index.position + DATALOG_CHUNKHEADER_SIZE) || storage_->read(&payload_[0], payloadSize) != payloadSize)
+        return false;
+
+    if (computeCrc(&payload_[0], payloadSize, crcInitialValue) != index.header.crc)
+    {
+        crcErrors_++;
+        return false;
+    }
+
+    return true;
+}
+
+// DataLog_Replayer
+
+VCTR::Core::DataLog_Replayer::DataLog_Replayer(DataLog_Reader &reader, float speed, size_t maxRecordsPerRun)
+{
+    reader_ = &reader;
+    speed_ = speed;
+    maxRecordsPerRun_ = maxRecordsPerRun;
+
+    strncpy(taskName_, "DataLog_Replayer", 50);
+    taskName_[49] = '\0';
+
+    setPaused(true);
+}
+
+void VCTR::Core::DataLog_Replayer::addChannel(DataLog_Replay_Channel &channel)
+{
+    channels_.appendIfNotInListArray(&channel);
+}
+
+void VCTR::Core::DataLog_Replayer::removeChannel(DataLog_Replay_Channel &channel)
+{
+    channels_.removeAllEqual(&channel);
+}
+
+void VCTR::Core::DataLog_Replayer::setSpeed(float speed)
+{
+
+    // Keep the current replay position when changing speed.
+    if (running_ && pending_)
+    {
+        logStart_ = pendingTimestamp_;
+        replayStart_ = NOW();
+    }
+
+    speed_ = speed;
+}
+
+float VCTR::Core::DataLog_Replayer::getSpeed() const
+{
+    return speed_;
+}
+
+bool VCTR::Core::DataLog_Replayer::start(int64_t logTime)
+{
+
+    if (logTime == 0)
+        logTime = reader_->getStartTime();
+
+    pending_ = reader_->seekTime(logTime);
+
+    // The index is per chunk. Skip records in the first chunk before the given time.
+    while (pending_ && (pending_ = reader_->nextRecord(pendingChannel_, pendingTimestamp_, pendingData_, pendingSize_)) && pendingTimestamp_ < logTime)
+        ;
+
+    if (!pending_)
+        return false;
+
+    logStart_ = logTime;
+    replayStart_ = NOW();
+    running_ = true;
+
+    setRelease(replayStart_);
+    setPaused(false);
+
+    return true;
+}
+
+void VCTR::Core::DataLog_Replayer::stop()
+{
+    running_ = false;
+    pending_ = false;
+    setPaused(true);
+}
+
+bool VCTR::Core::DataLog_Replayer::isRunning() const
+{
+    return running_;
+}
+
+void VCTR::Core::DataLog_Replayer::taskCheck()
+{
+
+    if (!running_ || !pending_)
+        return;
+
+    setRelease(getReplayTime(pendingTimestamp_));
+}
+
+void VCTR::Core::DataLog_Replayer::taskThread()
+{
+
+    int64_t now = NOW();
+    size_t replayed = 0;
+
+    while (pending_ && getReplayTime(pendingTimestamp_) <= now && (maxRecordsPerRun_ == 0 || replayed < maxRecordsPerRun_))
+    {
+        replayPending();
+        replayed++;
+
+        pending_ = reader_->nextRecord(pendingChannel_, pendingTimestamp_, pendingData_, pendingSize_);
+    }
+
+    if (!pending_)
+        stop();
+}
+
+int64_t VCTR::Core::DataLog_Replayer::getReplayTime(int64_t timestamp) const
+{
+
+    if (speed_ <= 0) // Max speed. Everything is due.
+        return replayStart_;
+
+    return replayStart_ + int64_t((timestamp - logStart_) / speed_);
+}
+
+void VCTR::Core::DataLog_Replayer::replayPending()
+{
+    for (size_t i = 0; i < channels_.size(); i++)
+    {
+        if (channels_[i]->channel_ == pendingChannel_)
+            channels_[i]->replay(pendingTimestamp_, pendingData_, pendingSize_);
+    }
+}
@@ -0,0 +1,71 @@
+#include "ExVectrCore/data_log_file.hpp"
+
+#include "stddef.h"
+#include "stdio.h"
+
+VCTR::Core::DataLog_File::DataLog_File() {}
+
+VCTR::Core::DataLog_File::DataLog_File(const char *path, bool write)
+{
+    open(path, write);
+}
+
+VCTR::Core::DataLog_File::~DataLog_File()
+{
+    close();
+}
+
+bool VCTR::Core::DataLog_File::open(const char *path, bool write)
+{
+    close();
+    file_ = fopen(path, write ? "wb+" : "rb");
+    return file_ != nullptr;
+}
+
+void VCTR::Core::DataLog_File::close()
+{
+    if (file_ == nullptr)
+        return;
+
+    fclose(file_);
+    file_ = nullptr;
+}
+
+bool VCTR::Core::DataLog_File::isOpen() const
+{
+    return file_ != nullptr;
+}
+
+size_t VCTR::Core::DataLog_File::write(const void *data, size_t size)
+{
+    if (file_ == nullptr)
+        return 0;
+    return fwrite(data, 1, size, file_);
+}
+
+size_t VCTR::Core::DataLog_File::read(void *data, size_t size)
+{
+    if (file_ == nullptr)
+        return 0;
+    return fread(data, 1, size, file_);
+}
+
+bool VCTR::Core::DataLog_File::seek(size_t position)
+{
+    if (file_ == nullptr)
+        return false;
+    return fseek(file_, long(position), SEEK_SET) == 0;
+}
+
+size_t VCTR::Core::DataLog_File::position() const
+{
+    if (file_ == nullptr)
+        return 0;
+    return size_t(ftell(file_));
+}
+
+void VCTR::Core::DataLog_File::flush()
+{
+    if (file_ != nullptr)
+        fflush(file_);
+}
@@ -0,0 +1,279 @@
+#include "ExVectrCore/list_reduce.hpp"
+
+#if !defined(EXVECTR_SIMD_DISABLE)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define EXVECTR_REDUCE_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define EXVECTR_REDUCE_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define EXVECTR_REDUCE_NEON
+#endif
+#endif
+
+namespace
+{
+
+#if defined(EXVECTR_REDUCE_AVX) || defined(EXVECTR_REDUCE_SSE)
+
+    inline float horizontalSum(__m128 value)
+    {
+        __m128 high = _mm_movehl_ps(value, value);
+        __m128 sum = _mm_add_ps(value, high);
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+    }
+
+    inline float horizontalMin(__m128 value)
+    {
+        __m128 min = _mm_min_ps(value, _mm_movehl_ps(value, value));
+        min = _mm_min_ss(min, _mm_shuffle_ps(min, min, 1));
+        return _mm_cvtss_f32(min);
+    }
+
+    inline float horizontalMax(__m128 value)
+    {
+        __m128 max = _mm_max_ps(value, _mm_movehl_ps(value, value));
+        max = _mm_max_ss(max, _mm_shuffle_ps(max, max, 1));
+        return _mm_cvtss_f32(max);
+    }
+
+#endif
+
+#if defined(EXVECTR_REDUCE_AVX)
+
+    inline __m128 combine(__m256 value)
+    {
+        return _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    }
+
+#endif
+
+} // namespace to hide local functions.
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        float reduceSum(const float *data, size_t size)
+        {
+            size_t i = 0;
+            float sum = 0;
+
+#if defined(EXVECTR_REDUCE_AVX)
+
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            for (; i + 16 <= size; i += 16)
+            {
+                sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(data + i));
+                sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(data + i + 8));
+            }
+            sum = horizontalSum(combine(_mm256_add_ps(sum0, sum1)));
+
+#elif defined(EXVECTR_REDUCE_SSE)
+
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (; i + 8 <= size; i += 8)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_loadu_ps(data + i));
+                sum1 = _mm_add_ps(sum1, _mm_loadu_ps(data + i + 4));
+            }
+            sum = horizontalSum(_mm_add_ps(sum0, sum1));
+
+#elif defined(EXVECTR_REDUCE_NEON)
+
+            float32x4_t sum0 = vdupq_n_f32(0);
+            float32x4_t sum1 = vdupq_n_f32(0);
+            for (; i + 8 <= size; i += 8)
+            {
+                sum0 = vaddq_f32(sum0, vld1q_f32(data + i));
+                sum1 = vaddq_f32(sum1, vld1q_f32(data + i + 4));
+            }
+            float32x4_t sum01 = vaddq_f32(sum0, sum1);
+            float32x2_t sumHalf = vadd_f32(vget_low_f32(sum01), vget_high_f32(sum01));
+            sum = vget_lane_f32(vpadd_f32(sumHalf, sumHalf), 0);
+
+#else
+
+            // Independent accumulators let the FPU pipeline additions.
+            float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (; i + 4 <= size; i += 4)
+            {
+                sum0 += data[i];
+                sum1 += data[i + 1];
+                sum2 += data[i + 2];
+                sum3 += data[i + 3];
+            }
+            sum = (sum0 + sum1) + (sum2 + sum3);
+
+#endif
+
+            for (; i < size; i++)
+                sum += data[i];
+
+            return sum;
+        }
+
+        void reduceMinMax(const float *data, size_t size, float &min, float &max)
+        {
+            size_t i = 0;
+
+#if defined(EXVECTR_REDUCE_AVX)
+
+            if (size >= 8)
+            {
+                __m256 min8 = _mm256_set1_ps(min);
+                __m256 max8 = _mm256_set1_ps(max);
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256 value = _mm256_loadu_ps(data + i);
+                    min8 = _mm256_min_ps(min8, value);
+                    max8 = _mm256_max_ps(max8, value);
+                }
+                min = horizontalMin(_mm_min_ps(_mm256_castps256_ps128(min8), _mm256_extractf128_ps(min8, 1)));
+                max = horizontalMax(_mm_max_ps(_mm256_castps256_ps128(max8), _mm256_extractf128_ps(max8, 1)));
+            }
+
+#elif defined(EXVECTR_REDUCE_SSE)
+
+            if (size >= 4)
+            {
+                __m128 min4 = _mm_set1_ps(min);
+                __m128 max4 = _mm_set1_ps(max);
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128 value = _mm_loadu_ps(data + i);
+                    min4 = _mm_min_ps(min4, value);
+                    max4 = _mm_max_ps(max4, value);
+                }
+                min = horizontalMin(min4);
+                max = horizontalMax(max4);
+            }
+
+#elif defined(EXVECTR_REDUCE_NEON)
+
+            if (size >= 4)
+            {
+                float32x4_t min4 = vdupq_n_f32(min);
+                float32x4_t max4 = vdupq_n_f32(max);
+                for (; i + 4 <= size; i += 4)
+                {
+                    float32x4_t value = vld1q_f32(data + i);
+                    min4 = vminq_f32(min4, value);
+                    max4 = vmaxq_f32(max4, value);
+                }
+                float32x2_t minHalf = vpmin_f32(vget_low_f32(min4), vget_high_f32(min4));
+                float32x2_t maxHalf = vpmax_f32(vget_low_f32(max4), vget_high_f32(max4));
+                min = vget_lane_f32(vpmin_f32(minHalf, minHalf), 0);
+                max = vget_lane_f32(vpmax_f32(maxHalf, maxHalf), 0);
+            }
+
+#endif
+
+            for (; i < size; i++)
+            {
+                if (data[i] < min)
+                    min = data[i];
+                if (max < data[i])
+                    max = data[i];
+            }
+        }
+
+        float reduceSquaredDeviation(const float *data, size_t size, const float &mean)
+        {
+            size_t i = 0;
+            float sum = 0;
+
+#if defined(EXVECTR_REDUCE_AVX)
+
+            __m256 mean8 = _mm256_set1_ps(mean);
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            for (; i + 16 <= size; i += 16)
+            {
+                __m256 diff0 = _mm256_sub_ps(_mm256_loadu_ps(data + i), mean8);
+                __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(data + i + 8), mean8);
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(diff0, diff0));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(diff1, diff1));
+            }
+            sum = horizontalSum(combine(_mm256_add_ps(sum0, sum1)));
+
+#elif defined(EXVECTR_REDUCE_SSE)
+
+            __m128 mean4 = _mm_set1_ps(mean);
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (; i + 8 <= size; i += 8)
+            {
+                __m128 diff0 = _mm_sub_ps(_mm_loadu_ps(data + i), mean4);
+                __m128 diff1 = _mm_sub_ps(_mm_loadu_ps(data + i + 4), mean4);
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(diff0, diff0));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(diff1, diff1));
+            }
+            sum = horizontalSum(_mm_add_ps(sum0, sum1));
+
+#elif defined(EXVECTR_REDUCE_NEON)
+
+            float32x4_t mean4 = vdupq_n_f32(mean);
+            float32x4_t sum0 = vdupq_n_f32(0);
+            float32x4_t sum1 = vdupq_n_f32(0);
+            for (; i + 8 <= size; i += 8)
+            {
+                float32x4_t diff0 = vsubq_f32(vld1q_f32(data + i), mean4);
+                float32x4_t diff1 = vsubq_f32(vld1q_f32(data + i + 4), mean4);
+                sum0 = vmlaq_f32(sum0, diff0, diff0);
+                sum1 = vmlaq_f32(sum1, diff1, diff1);
+            }
+            float32x4_t sum01 = vaddq_f32(sum0, sum1);
+            float32x2_t sumHalf = vadd_f32(vget_low_f32(sum01), vget_high_f32(sum01));
+            sum = vget_lane_f32(vpadd_f32(sumHalf, sumHalf), 0);
+
+#else
+
+            float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (; i + 4 <= size; i += 4)
+            {
+                float diff0 = data[i] - mean;
+                float diff1 = data[i + 1] - mean;
+                float diff2 = data[i + 2] - mean;
+                float diff3 = data[i + 3] - mean;
+                sum0 += diff0 * diff0;
+                sum1 += diff1 * diff1;
+                sum2 += diff2 * diff2;
+                sum3 += diff3 * diff3;
+            }
+            sum = (sum0 + sum1) + (sum2 + sum3);
+
+#endif
+
+            for (; i < size; i++)
+            {
+                float diff = data[i] - mean;
+                sum += diff * diff;
+            }
+
+            return sum;
+        }
+
+        const char *getReduceKernelName()
+        {
+#if defined(EXVECTR_REDUCE_AVX)
+            return "avx";
+#elif defined(EXVECTR_REDUCE_SSE)
+            return "sse";
+#elif defined(EXVECTR_REDUCE_NEON)
+            return "neon";
+#else
+            return "scalar";
+#endif
+        }
+
+    }
+
+}
@@ -5,7 +5,7 @@
 #include "stdarg.h"
 
 #include "ExVectrCore/topic.hpp"
-#include "ExVectrCore/list_array.hpp"
+#include "ExVectrCore/list_small.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////
 //                      Below is the API for a support library
@@ -102,7 +102,8 @@ namespace
 
 void _putchar(char c)
 {
-    static VCTR::Core::ListArray<char> chars;
+    // Most messages fit inline, longer ones spill to the heap.
+    static VCTR::Core::ListSmall<char, 128> chars;
 
     chars.append(c);
     if (c == '\0')
@@ -0,0 +1,127 @@
+#include "ExVectrCore/running_statistics.hpp"
+
+#include "math.h"
+
+namespace VCTR
+{
+
+    namespace Core
+    {
+
+        void RunningStatistics::reset()
+        {
+            count_ = 0;
+            sum_ = 0;
+            sumCompensation_ = 0;
+            mean_ = 0;
+            m2_ = 0;
+            min_ = 0;
+            max_ = 0;
+            extremesValid_ = true;
+        }
+
+        void RunningStatistics::add(double value)
+        {
+            double y = value - sumCompensation_;
+            double t = sum_ + y;
+            sumCompensation_ = (t - sum_) - y;
+            sum_ = t;
+
+            count_++;
+            double delta = value - mean_;
+            mean_ += delta / count_;
+            m2_ += delta * (value - mean_);
+
+            if (count_ == 1)
+            {
+                min_ = value;
+                max_ = value;
+            }
+            else if (extremesValid_)
+            {
+                if (value < min_)
+                    min_ = value;
+                if (value > max_)
+                    max_ = value;
+            }
+        }
+
+        void RunningStatistics::remove(double value)
+        {
+            // Start from scratch once empty, this also clears any accumulated rounding error.
+            if (count_ <= 1)
+            {
+                reset();
+                return;
+            }
+
+            double y = -value - sumCompensation_;
+            double t = sum_ + y;
+            sumCompensation_ = (t - sum_) - y;
+            sum_ = t;
+
+            count_--;
+            double delta = value - mean_;
+            mean_ -= delta / count_;
+            m2_ -= delta * (value - mean_);
+            if (m2_ < 0)
+                m2_ = 0;
+
+            if (value <= min_ || value >= max_)
+                extremesValid_ = false;
+        }
+
+        size_t RunningStatistics::getCount() const
+        {
+            return count_;
+        }
+
+        double RunningStatistics::getSum() const
+        {
+            return sum_;
+        }
+
+        double RunningStatistics::getMean() const
+        {
+            if (count_ == 0)
+                return 0;
+            return sum_ / count_;
+        }
+
+        double RunningStatistics::getVariance() const
+        {
+            if (count_ < 2)
+                return 0;
+            return m2_ / (count_ - 1);
+        }
+
+        double RunningStatistics::getStandardDeviation() const
+        {
+            return sqrt(getVariance());
+        }
+
+        bool RunningStatistics::hasExtremes() const
+        {
+            return extremesValid_;
+        }
+
+        double RunningStatistics::getMin() const
+        {
+            return min_;
+        }
+
+        double RunningStatistics::getMax() const
+        {
+            return max_;
+        }
+
+        void RunningStatistics::setExtremes(double min, double max)
+        {
+            min_ = min;
+            max_ = max;
+            extremesValid_ = true;
+        }
+
+    }
+
+}
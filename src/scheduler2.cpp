@@ -4,7 +4,7 @@
 #include "stdint.h"
 
 #include "ExVectrCore/list.hpp"
-#include "ExVectrCore/List_linked.hpp"
+#include "ExVectrCore/list_intrusive.hpp"
 #include "ExVectrCore/time_definitions.hpp"
 #include "ExVectrCore/print.hpp"
 
@@ -25,23 +25,32 @@ VCTR::Core::Scheduler::Scheduler(Clock_Source &clockSource)
     timeSource_.setClockSource(clockSource);
 }
 
-const VCTR::Core::List<VCTR::Core::Scheduler::Task *> &VCTR::Core::Scheduler::getTasks() const
+VCTR::Core::Scheduler::~Scheduler()
 {
+    for (Task *task : tasks_)
+    {
+        tasks_.remove(task->taskListElement_);
+        task->scheduler_ = nullptr;
+    }
+}
 
-    if (tasks_ == nullptr)
-        return List<Task *>::empty();
+const VCTR::Core::List<VCTR::Core::Scheduler::Task *> &VCTR::Core::Scheduler::getTasks() const
+{
 
-    return *tasks_;
+    return tasks_;
 }
 
 bool VCTR::Core::Scheduler::addTask(Scheduler::Task &task)
 {
 
-    if (tasks_ == nullptr)
-        tasks_ = &task.taskListElement_;
-    else
-        tasks_->append(task.taskListElement_);
+    if (task.scheduler_ == this)
+        return true;
 
+    // A task can only be in one scheduler.
+    if (task.scheduler_ != nullptr)
+        task.scheduler_->removeTask(task);
+
+    tasks_.pushBack(task.taskListElement_);
     task.scheduler_ = this;
 
     return true;
@@ -50,24 +59,13 @@ bool VCTR::Core::Scheduler::addTask(Scheduler::Task &task)
 bool VCTR::Core::Scheduler::removeTask(Scheduler::Task &task)
 {
 
-    // Iterate through the list and find if the task is in the list. Remove if found.
-    auto list = tasks_;
-    while (list != nullptr)
-    {
-        if (list == &task.taskListElement_)
-        {
-
-            if (list == tasks_)
-                tasks_ = list->getNext();
+    // The task knows its scheduler, so no search is needed.
+    if (task.scheduler_ != this)
+        return false;
 
-            list->remove();
-            task.scheduler_ = nullptr;
-            return true;
-        }
-        list = list->getNext();
-    }
-
-    return false;
+    tasks_.remove(task.taskListElement_);
+    task.scheduler_ = nullptr;
+    return true;
 }
 
 int32_t VCTR::Core::Scheduler::getTaskPseudoPriority(const VCTR::Core::Scheduler::Task &task)
@@ -101,16 +99,14 @@ int32_t VCTR::Core::Scheduler::getTaskPseudoPriority(const VCTR::Core::Scheduler
 int64_t VCTR::Core::Scheduler::getNextTaskRelease() const
 {
 
-    if (tasks_ == nullptr)
+    if (tasks_.isEmpty())
         return VCTR::Core::END_OF_TIME;
 
-    int64_t earliest = (*tasks_)[0]->getRelease();
-    auto task = tasks_->getNext();
-    while (task != nullptr && task != tasks_)
+    int64_t earliest = tasks_.getFirst()->getItem()->getRelease();
+    for (const Task *task : tasks_)
     {
-        if ((*task)[0]->getRelease() < earliest)
-            earliest = (*task)[0]->getRelease();
-        task = task->getNext();
+        if (task->getRelease() < earliest)
+            earliest = task->getRelease();
     }
 
     return earliest;
@@ -119,7 +115,7 @@ int64_t VCTR::Core::Scheduler::getNextTaskRelease() const
 void VCTR::Core::Scheduler::tick()
 {
 
-    if (tasks_ == nullptr) //Return if there are no tasks
+    if (tasks_.isEmpty()) //Return if there are no tasks
         return;
 
     /**
@@ -129,47 +125,46 @@ void VCTR::Core::Scheduler::tick()
      * - Increment the misses counter for all tasks that should run. (The selected task to run is will be set to 0, once it has run.)
      * - Run the task with the highest pseudo priority.
      */
-    auto task = tasks_;
     auto highestPriority = 0;
-    VCTR::Core::ListLinked<VCTR::Core::Scheduler::Task *> *highestPriorityTask = nullptr;
-    VCTR::Core::ListLinked<VCTR::Core::Scheduler::Task *> *nextTaskToRun = nullptr;
+    Task *highestPriorityTask = nullptr;
+    Task *nextTaskToRun = nullptr;
     bool sleepingAllowed = true;
-    while (task != nullptr)
+    for (Task *task : tasks_)
     {
 
-        (*task)[0]->taskCheck();
-        (*task)[0]->pseudoPriority = getTaskPseudoPriority(*(*task)[0]);
+        task->taskCheck();
+        if (task->scheduler_ != this) // Removed itself in taskCheck().
+            continue;
+        task->pseudoPriority = getTaskPseudoPriority(*task);
 
-        if (!(*task)[0]->getAllowSleep())
+        if (!task->getAllowSleep())
             sleepingAllowed = false;
 
-        if (!(*task)[0]->getPaused()) {
+        if (!task->getPaused()) {
 
-            auto release = (*task)[0]->getRelease();
+            auto release = task->getRelease();
 
-            if (nextTaskToRun == nullptr || release < (*nextTaskToRun)[0]->getRelease())
+            if (nextTaskToRun == nullptr || release < nextTaskToRun->getRelease())
                 nextTaskToRun = task;
 
             if (NOW() > release)
             {
-                (*task)[0]->misses++;
+                task->misses++;
 
-                if ((*task)[0]->pseudoPriority > highestPriority)
+                if (task->pseudoPriority > highestPriority)
                 {
-                    highestPriority = (*task)[0]->pseudoPriority;
+                    highestPriority = task->pseudoPriority;
                     highestPriorityTask = task;
                 }
             }
 
         }
-
-        task = task->getNext();
     }
 
     if (highestPriorityTask != nullptr) // Is a task ready to run?
     {
 
-        auto taskRun = (*highestPriorityTask)[0];
+        auto taskRun = highestPriorityTask;
 
         taskRun->misses = 0;
         taskRun->runCounter++;
@@ -200,7 +195,7 @@ void VCTR::Core::Scheduler::tick()
 
     } else if (sleepFunction_ != nullptr && sleepingAllowed && nextTaskToRun != nullptr) { //We can sleep if we have a sleep function, sleeping is allowed by all tasks and we have a task waiting to be run
         
-        auto sleepTime = (*nextTaskToRun)[0]->getRelease() - NOW();
+        auto sleepTime = nextTaskToRun->getRelease() - NOW();
 
         if (sleepTime > sleepMargin_ + minSleepTime_)
             sleepFunction_(sleepTime - sleepMargin_);
@@ -222,7 +217,7 @@ void VCTR::Core::Scheduler::setSleepFunction(void (*sleepFunction)(int64_t))
 
 VCTR::Core::Scheduler::Task::Task()
 {
-    taskListElement_[0] = this;
+    taskListElement_.setItem(this);
     taskName_[0] = '\0';
 }
 
@@ -0,0 +1,290 @@
+#include "ExVectrCore/topic_bridge.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+VCTR::Core::Topic_Bridge::Topic_Bridge(Topic_Bridge_Stream &stream, size_t sendSize, size_t receiveSize, int64_t interval_ns) : Task_Periodic("Topic_Bridge", interval_ns)
+{
+    if (receiveSize < BRIDGE_FRAMEHEADER_SIZE)
+        receiveSize = BRIDGE_FRAMEHEADER_SIZE;
+
+    stream_ = &stream;
+    sendSize_ = sendSize;
+    receiveSize_ = receiveSize;
+
+    // Allocated once, no further heap usage.
+    sendBuffer_ = new uint8_t[sendSize_];
+    receiveBuffer_ = new uint8_t[receiveSize_];
+}
+
+VCTR::Core::Topic_Bridge::~Topic_Bridge()
+{
+    delete[] sendBuffer_;
+    delete[] receiveBuffer_;
+}
+
+bool VCTR::Core::Topic_Bridge::sendFrame(const uint8_t *frame, size_t size)
+{
+
+    if (!canSend(size))
+        return false;
+
+    writeRing(frame, size);
+    sentFrames_++;
+
+    return true;
+}
+
+bool VCTR::Core::Topic_Bridge::sendFrame(uint16_t channel, int64_t timestamp, const void *data, uint16_t size)
+{
+
+    if (!canSend(BRIDGE_FRAMEHEADER_SIZE + size))
+        return false;
+
+    DataBuffer<BRIDGE_FRAMEHEADER_SIZE> header;
+    header.write(channel);
+    header.write(size);
+    header.write(timestamp);
+
+    writeRing(header.getData(), BRIDGE_FRAMEHEADER_SIZE);
+    writeRing(data, size);
+    sentFrames_++;
+
+    return true;
+}
+
+bool VCTR::Core::Topic_Bridge::canSend(size_t size)
+{
+
+    if (sendSize_ - sendUsed_ < size || (dropUnconnected_ && !connected_))
+    {
+        droppedFrames_++;
+        return false;
+    }
+
+    return true;
+}
+
+void VCTR::Core::Topic_Bridge::writeRing(const void *data, size_t size)
+{
+
+    // Copy into ring, wrapping around the end if needed.
+    size_t head = (sendTail_ + sendUsed_) % sendSize_;
+    size_t firstBlock = sendSize_ - head;
+    if (firstBlock > size)
+        firstBlock = size;
+
+    memcpy(&sendBuffer_[head], data, firstBlock);
+    memcpy(sendBuffer_, static_cast<const uint8_t *>(data) + firstBlock, size - firstBlock);
+
+    sendUsed_ += size;
+    if (sendUsed_ > sendUsedMax_)
+        sendUsedMax_ = sendUsed_;
+}
+
+void VCTR::Core::Topic_Bridge::addChannel(Topic_Bridge_Channel &channel)
+{
+    channels_.appendIfNotInListArray(&channel);
+}
+
+void VCTR::Core::Topic_Bridge::removeChannel(Topic_Bridge_Channel &channel)
+{
+    channels_.removeAllEqual(&channel);
+}
+
+void VCTR::Core::Topic_Bridge::setDropUnconnected(bool drop)
+{
+    dropUnconnected_ = drop;
+}
+
+bool VCTR::Core::Topic_Bridge::isConnected() const
+{
+    return connected_;
+}
+
+float VCTR::Core::Topic_Bridge::getFill() const
+{
+    return float(sendUsed_) / sendSize_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getFillMax() const
+{
+    return sendUsedMax_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getSentFrames() const
+{
+    return sentFrames_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getDroppedFrames() const
+{
+    return droppedFrames_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getBytesWritten() const
+{
+    return bytesWritten_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getReceivedFrames() const
+{
+    return receivedFrames_;
+}
+
+size_t VCTR::Core::Topic_Bridge::getReceiveErrors() const
+{
+    return receiveErrors_;
+}
+
+void VCTR::Core::Topic_Bridge::flush()
+{
+
+    while (sendUsed_ > 0)
+    {
+
+        // The used part of the ring is at most two blocks. Both go out in a single write.
+        Topic_Bridge_Segment segments[2];
+        size_t numSegments = 1;
+
+        segments[0].data = &sendBuffer_[sendTail_];
+        segments[0].size = sendSize_ - sendTail_;
+        if (segments[0].size >= sendUsed_)
+        {
+            segments[0].size = sendUsed_;
+        }
+        else
+        {
+            segments[1].data = sendBuffer_;
+            segments[1].size = sendUsed_ - segments[0].size;
+            numSegments = 2;
+        }
+
+        size_t written = stream_->writeSegments(segments, numSegments);
+        if (written == 0) // Stream is full. Try again next run.
+            return;
+
+        if (written > sendUsed_)
+            written = sendUsed_;
+
+        sendTail_ = (sendTail_ + written) % sendSize_;
+        sendUsed_ -= written;
+        bytesWritten_ += written;
+        advanceSentFrames(written);
+    }
+
+    // Empty, so start at the beginning to keep the next write in one block.
+    sendTail_ = 0;
+    sendFrameStart_ = 0;
+}
+
+void VCTR::Core::Topic_Bridge::advanceSentFrames(size_t written)
+{
+
+    sendFrameSent_ += written;
+
+    while (true)
+    {
+        size_t frameSize = getFrameSize(sendFrameStart_);
+        if (sendFrameSent_ < frameSize)
+            return;
+
+        sendFrameSent_ -= frameSize;
+        sendFrameStart_ = (sendFrameStart_ + frameSize) % sendSize_;
+    }
+}
+
+size_t VCTR::Core::Topic_Bridge::getFrameSize(size_t position) const
+{
+
+    // The header can wrap around the end of the ring.
+    uint8_t sizeBytes[2];
+    sizeBytes[0] = sendBuffer_[(position + 2) % sendSize_];
+    sizeBytes[1] = sendBuffer_[(position + 3) % sendSize_];
+
+    uint16_t size;
+    memcpy(&size, sizeBytes, sizeof(size));
+
+    return BRIDGE_FRAMEHEADER_SIZE + size;
+}
+
+void VCTR::Core::Topic_Bridge::taskThread()
+{
+
+    connected_ = stream_->isConnected();
+    if (!connected_)
+    {
+        if (dropUnconnected_)
+        {
+            sendTail_ = 0;
+            sendUsed_ = 0;
+            sendFrameStart_ = 0;
+        }
+        else if (sendFrameSent_ > 0) // Skip the rest of a partly sent frame, so the new connection starts at a frame boundary.
+        {
+            size_t rest = getFrameSize(sendFrameStart_) - sendFrameSent_;
+            sendTail_ = (sendTail_ + rest) % sendSize_;
+            sendUsed_ -= rest;
+            sendFrameStart_ = sendTail_;
+            droppedFrames_++;
+        }
+        sendFrameSent_ = 0;
+        receiveUsed_ = 0;
+        return;
+    }
+
+    flush();
+    receive();
+}
+
+void VCTR::Core::Topic_Bridge::receive()
+{
+
+    while (true)
+    {
+
+        size_t numRead = stream_->read(&receiveBuffer_[receiveUsed_], receiveSize_ - receiveUsed_);
+        if (numRead == 0)
+            return;
+        receiveUsed_ += numRead;
+
+        // Give out all complete frames.
+        size_t pos = 0;
+        while (receiveUsed_ - pos >= BRIDGE_FRAMEHEADER_SIZE)
+        {
+            uint16_t channel, size;
+            int64_t timestamp;
+            memcpy(&channel, &receiveBuffer_[pos], sizeof(channel));
+            memcpy(&size, &receiveBuffer_[pos + 2], sizeof(size));
+            memcpy(&timestamp, &receiveBuffer_[pos + 4], sizeof(timestamp));
+
+            size_t frameSize = BRIDGE_FRAMEHEADER_SIZE + size;
+            if (frameSize > receiveSize_) // Can never be received. Stream is out of sync.
+            {
+                // The rest of the frame is still in the stream and would be read as frames. Reconnect to start over at a frame boundary.
+                receiveErrors_++;
+                receiveUsed_ = 0;
+                stream_->disconnect();
+                connected_ = false;
+                return;
+            }
+
+            if (receiveUsed_ - pos < frameSize)
+                break;
+
+            for (size_t i = 0; i < channels_.size(); i++)
+            {
+                if (channels_[i]->channel_ == channel)
+                    channels_[i]->receiveFrame(timestamp, &receiveBuffer_[pos + BRIDGE_FRAMEHEADER_SIZE], size);
+            }
+
+            receivedFrames_++;
+            pos += frameSize;
+        }
+
+        // Keep the incomplete frame at the start of the buffer.
+        receiveUsed_ -= pos;
+        memmove(receiveBuffer_, &receiveBuffer_[pos], receiveUsed_);
+    }
+}
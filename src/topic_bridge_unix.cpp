@@ -0,0 +1,203 @@
+#include "ExVectrCore/topic_bridge_unix.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "stddef.h"
+#include "stdint.h"
+#include "string.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+
+    /// @brief Sets the given socket to non-blocking. A closed connection must not raise SIGPIPE.
+    bool setNonBlocking(int fd)
+    {
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    /// @brief Fills the socket address for the given path.
+    void getAddress(const char *path, sockaddr_un &address)
+    {
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    }
+
+} // namespace to hide local functions.
+
+VCTR::Core::Topic_Bridge_UnixSocket::Topic_Bridge_UnixSocket()
+{
+    path_[0] = '\0';
+}
+
+VCTR::Core::Topic_Bridge_UnixSocket::Topic_Bridge_UnixSocket(const char *path, bool listen)
+{
+    path_[0] = '\0';
+    open(path, listen);
+}
+
+VCTR::Core::Topic_Bridge_UnixSocket::~Topic_Bridge_UnixSocket()
+{
+    close();
+}
+
+void VCTR::Core::Topic_Bridge_UnixSocket::open(const char *path, bool listen)
+{
+    close();
+
+    strncpy(path_, path, sizeof(path_) - 1);
+    path_[sizeof(path_) - 1] = '\0';
+    listen_ = listen;
+}
+
+void VCTR::Core::Topic_Bridge_UnixSocket::close()
+{
+    disconnect();
+
+    if (listenFd_ >= 0)
+    {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        unlink(path_);
+    }
+}
+
+void VCTR::Core::Topic_Bridge_UnixSocket::disconnect()
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool VCTR::Core::Topic_Bridge_UnixSocket::isConnected()
+{
+
+    if (fd_ >= 0)
+        return true;
+
+    if (path_[0] == '\0')
+        return false;
+
+    sockaddr_un address;
+    getAddress(path_, address);
+
+    if (!listen_)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return false;
+
+        if (connect(fd, (sockaddr *)&address, sizeof(address)) != 0 || !setNonBlocking(fd))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        fd_ = fd;
+        return true;
+    }
+
+    if (listenFd_ < 0)
+    {
+        listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd_ < 0)
+            return false;
+
+        unlink(path_); // Remove socket file left over from a previous run.
+        if (bind(listenFd_, (sockaddr *)&address, sizeof(address)) != 0 || listen(listenFd_, 1) != 0 || !setNonBlocking(listenFd_))
+        {
+            ::close(listenFd_);
+            listenFd_ = -1;
+            return false;
+        }
+    }
+
+    int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0)
+        return false;
+
+    if (!setNonBlocking(fd))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    return true;
+}
+
+size_t VCTR::Core::Topic_Bridge_UnixSocket::writeSegments(const Topic_Bridge_Segment *segments, size_t numSegments)
+{
+
+    if (fd_ < 0)
+        return 0;
+
+    iovec iov[8];
+    if (numSegments > 8)
+        numSegments = 8;
+
+    for (size_t i = 0; i < numSegments; i++)
+    {
+        iov[i].iov_base = const_cast<void *>(segments[i].data);
+        iov[i].iov_len = segments[i].size;
+    }
+
+    // Same as writev(), but allows suppressing SIGPIPE.
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = numSegments;
+
+#ifdef MSG_NOSIGNAL
+    ssize_t written = sendmsg(fd_, &message, MSG_NOSIGNAL);
+#else
+    ssize_t written = sendmsg(fd_, &message, 0);
+#endif
+    if (written < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            disconnect();
+        return 0;
+    }
+
+    return written;
+}
+
+size_t VCTR::Core::Topic_Bridge_UnixSocket::read(void *data, size_t size)
+{
+
+    if (fd_ < 0 || size == 0)
+        return 0;
+
+    ssize_t numRead = recv(fd_, data, size, 0);
+    if (numRead == 0) // Other side closed.
+    {
+        disconnect();
+        return 0;
+    }
+
+    if (numRead < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            disconnect();
+        return 0;
+    }
+
+    return numRead;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "ExVectrCore/topic_registry.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+
+namespace
+{
+    /// @brief Initial number of entries in the hash table. Must be a power of two.
+    constexpr size_t initialCapacity = 16;
+
+} // namespace to hide local variables.
+
+VCTR::Core::TopicRegistry &VCTR::Core::getTopicRegistry()
+{
+    static VCTR::Core::TopicRegistry registry;
+    return registry;
+}
+
+VCTR::Core::TopicRegistry::TopicRegistry()
+{
+    capacity_ = initialCapacity;
+    table_ = new Entry[capacity_];
+}
+
+VCTR::Core::TopicRegistry::~TopicRegistry()
+{
+    delete[] table_;
+}
+
+void *VCTR::Core::TopicRegistry::find(uint32_t nameHash, TypeId &type, uint32_t nameCheck) const
+{
+
+    const Entry &entry = table_[findIndex(nameHash, nameCheck)];
+
+    type = entry.ops != nullptr ? entry.ops->typeId : nullptr;
+    return entry.topic;
+}
+
+VCTR::Core::Topic_Handle VCTR::Core::TopicRegistry::findHandle(uint32_t nameHash, uint32_t nameCheck) const
+{
+
+    const Entry &entry = table_[findIndex(nameHash, nameCheck)];
+
+    return Topic_Handle(entry.topic, entry.ops);
+}
+
+bool VCTR::Core::TopicRegistry::add(uint32_t nameHash, const Topic_Handle_Ops *ops, void *topic, uint32_t nameCheck)
+{
+
+    // Keep load factor below 3/4 so probing stays short.
+    if ((numTopics_ + 1) * 4 > capacity_ * 3)
+        grow();
+
+    Entry &entry = table_[findIndex(nameHash, nameCheck)];
+    if (entry.ops != nullptr)
+        return false;
+
+    entry.nameHash = nameHash;
+    entry.nameCheck = nameCheck;
+    entry.ops = ops;
+    entry.topic = topic;
+    numTopics_++;
+
+    return true;
+}
+
+size_t VCTR::Core::TopicRegistry::size() const
+{
+    return numTopics_;
+}
+
+size_t VCTR::Core::TopicRegistry::findIndex(uint32_t nameHash, uint32_t nameCheck) const
+{
+
+    size_t mask = capacity_ - 1;
+    size_t index = nameHash & mask;
+
+    // Linear probing. Table is never full so this always ends.
+    // Names with the same hash but different checks are different topics, so probing continues past them.
+    while (table_[index].ops != nullptr)
+    {
+        const Entry &entry = table_[index];
+        if (entry.nameHash == nameHash && (nameCheck == 0 || entry.nameCheck == 0 || entry.nameCheck == nameCheck))
+            break;
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+void VCTR::Core::TopicRegistry::grow()
+{
+
+    Entry *oldTable = table_;
+    size_t oldCapacity = capacity_;
+
+    capacity_ = oldCapacity * 2;
+    table_ = new Entry[capacity_];
+
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (oldTable[i].ops != nullptr)
+            table_[findIndex(oldTable[i].nameHash, oldTable[i].nameCheck)] = oldTable[i];
+    }
+
+    delete[] oldTable;
+}
@@ -0,0 +1,62 @@
+#include "ExVectrCore/topic_stats.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include "ExVectrCore/time_definitions.hpp"
+
+namespace
+{
+    /// @brief Start of the global list of topic statistics.
+    VCTR::Core::TopicStats *firstStats = nullptr;
+
+} // namespace to hide local variables.
+
+VCTR::Core::TopicStats::TopicStats(const void *topic, size_t itemSize)
+{
+    stats_.topic = topic;
+    stats_.itemSize = itemSize;
+
+    next_ = firstStats;
+    if (firstStats != nullptr)
+        firstStats->prev_ = this;
+    firstStats = this;
+}
+
+VCTR::Core::TopicStats::~TopicStats()
+{
+    if (prev_ != nullptr)
+        prev_->next_ = next_;
+    else
+        firstStats = next_;
+
+    if (next_ != nullptr)
+        next_->prev_ = prev_;
+}
+
+VCTR::Core::TopicStats *VCTR::Core::TopicStats::getFirst()
+{
+    return firstStats;
+}
+
+VCTR::Core::TopicStats *VCTR::Core::TopicStats::getNext() const
+{
+    return next_;
+}
+
+VCTR::Core::TopicStats_Snapshot VCTR::Core::TopicStats::snapshot(int64_t time)
+{
+
+    if (lastSnapshotTime_ != 0 && time > lastSnapshotTime_)
+        stats_.publishRate = float(stats_.publishCount - lastPublishCount_) * SECONDS / float(time - lastSnapshotTime_);
+
+    lastPublishCount_ = stats_.publishCount;
+    lastSnapshotTime_ = time;
+
+    return stats_;
+}
+
+const VCTR::Core::TopicStats_Snapshot &VCTR::Core::TopicStats::getStats() const
+{
+    return stats_;
+}
@@ -0,0 +1,31 @@
+#include "ExVectrCore/topic_stats_task.hpp"
+
+#include "stddef.h"
+#include "stdint.h"
+
+#include "ExVectrCore/time_definitions.hpp"
+
+VCTR::Core::Topic<VCTR::Core::TopicStats_Snapshot> &VCTR::Core::getTopicStatsTopic()
+{
+    static Topic<TopicStats_Snapshot> topic;
+    return topic;
+}
+
+VCTR::Core::TopicStats_Task::TopicStats_Task(int64_t interval_ns) : Task_Periodic("TopicStats_Task", interval_ns) {}
+
+void VCTR::Core::TopicStats_Task::taskThread()
+{
+
+#ifdef EXVECTR_TOPIC_STATS_ENABLE
+
+    int64_t time = NOW();
+    Topic<TopicStats_Snapshot> &statsTopic = getTopicStatsTopic();
+
+    for (TopicStats *stats = TopicStats::getFirst(); stats != nullptr; stats = stats->getNext())
+    {
+        TopicStats_Snapshot snapshot = stats->snapshot(time);
+        statsTopic.publish(snapshot);
+    }
+
+#endif
+}